@@ -0,0 +1,91 @@
+// Host test of the P² quantile estimator of victron_statistics against exact quantiles.
+//
+//   g++ -O2 -std=gnu++17 -Icomponents benchmarks/p2_quantile_test.cpp components/victron_statistics/p2_quantile.cpp -o p2_quantile_test
+//
+// - the worked example of the paper (Jain and Chlamtac, 1985): the median of its 20 observations is 4.44
+// - fewer than five samples, where the exact quantile is returned
+// - shuffled, sorted and skewed sequences whose exact quantiles are known
+
+#include "victron_statistics/p2_quantile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using esphome::victron_statistics::P2Quantile;
+
+static int failures = 0;
+
+static void check(const char *name, float quantile, float estimate, float expected, float tolerance) {
+  const bool ok = std::fabs(estimate - expected) <= tolerance;
+  printf("%-28s p=%.2f  estimate %10.4f  exact %10.4f  %s\n", name, quantile, estimate, expected, ok ? "ok" : "FAIL");
+  if (!ok)
+    failures++;
+}
+
+static float exact(std::vector<float> samples, float quantile) {
+  std::sort(samples.begin(), samples.end());
+  return samples[(size_t) lroundf(quantile * (samples.size() - 1))];
+}
+
+// The estimate is expected within `tolerance` of the range of the samples
+static void check_sequence(const char *name, const std::vector<float> &samples, float tolerance) {
+  const auto range = std::minmax_element(samples.begin(), samples.end());
+  for (const float quantile : {0.05f, 0.25f, 0.5f, 0.9f, 0.99f}) {
+    P2Quantile estimator(quantile);
+    for (const float sample : samples)
+      estimator.add(sample);
+    check(name, quantile, estimator.value(), exact(samples, quantile), tolerance * (*range.second - *range.first));
+  }
+}
+
+int main() {
+  // Table 1 of the paper
+  const float paper[] = {0.02f,  0.15f, 0.74f,  3.39f, 0.83f, 22.37f, 10.15f, 15.43f, 38.62f, 15.92f,
+                         34.60f, 10.28f, 1.47f, 0.40f, 0.05f, 11.39f, 0.27f,  0.42f,  0.09f,  11.37f};
+  P2Quantile median(0.5f);
+  for (const float sample : paper)
+    median.add(sample);
+  check("paper example", 0.5f, median.value(), 4.44f, 0.005f);
+
+  P2Quantile empty(0.5f);
+  const bool nan = std::isnan(empty.value());
+  printf("%-28s %s\n", "no sample is NAN", nan ? "ok" : "FAIL");
+  if (!nan)
+    failures++;
+
+  P2Quantile few(0.5f);
+  for (const float sample : {3.0f, 1.0f, 2.0f})
+    few.add(sample);
+  check("three samples", 0.5f, few.value(), 2.0f, 0.0f);
+
+  std::mt19937 random(1);
+  std::vector<float> uniform;
+  std::uniform_real_distribution<float> uniform_distribution(11.5f, 14.5f);
+  for (int i = 0; i < 10000; i++)
+    uniform.push_back(uniform_distribution(random));
+  check_sequence("uniform", uniform, 0.01f);
+
+  std::vector<float> normal;
+  std::normal_distribution<float> normal_distribution(13.2f, 0.3f);
+  for (int i = 0; i < 10000; i++)
+    normal.push_back(normal_distribution(random));
+  check_sequence("normal", normal, 0.01f);
+
+  // Panel power: long runs of 0 at night, skewed during the day
+  std::vector<float> skewed;
+  std::exponential_distribution<float> exponential_distribution(1.0f / 80.0f);
+  for (int i = 0; i < 10000; i++)
+    skewed.push_back(i % 3 == 0 ? 0.0f : exponential_distribution(random));
+  check_sequence("skewed", skewed, 0.01f);
+
+  std::vector<float> ascending;
+  for (int i = 0; i < 3600; i++)
+    ascending.push_back(i);
+  check_sequence("ascending", ascending, 0.01f);
+
+  printf("%s\n", failures == 0 ? "PASSED" : "FAILED");
+  return failures == 0 ? 0 : 1;
+}
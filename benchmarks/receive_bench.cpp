@@ -0,0 +1,192 @@
+// Host benchmark of the receive path: byte at a time vs. chunked reads with the span-wise frame assembler.
+//
+//   g++ -O2 -std=gnu++17 -Icomponents benchmarks/receive_bench.cpp components/victron/frame_assembler.cpp -o bench
+//
+// The UART is modelled like the ESPHome UART component: read_byte() is a read_array() of one byte through a
+// virtual call. The real UART drivers cost more per call (locking, ring buffer), which isn't modelled.
+//
+// Three receive paths are compared:
+// - the parser of loop() before the chunked receive path, std::string label and value filled by read_byte()
+//   (no checksum, fingerprint or HEX handling)
+// - the current frame assembler fed one byte per read_byte() call
+// - the current frame assembler fed chunks of CHUNK_SIZE bytes
+
+#include "victron/frame_assembler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using esphome::victron::FrameAssembler;
+
+static const int FRAMES = 200000;
+static const size_t CHUNK_SIZE = 64;
+
+class Uart {
+ public:
+  virtual ~Uart() = default;
+  virtual int available() = 0;
+  virtual bool read_array(uint8_t *data, size_t len) = 0;
+  bool read_byte(uint8_t *data) { return this->read_array(data, 1); }
+};
+
+class BufferUart : public Uart {
+ public:
+  explicit BufferUart(const std::string &data) : data_(data) {}
+  int available() override { return this->data_.size() - this->pos_; }
+  bool read_array(uint8_t *data, size_t len) override {
+    if (this->data_.size() - this->pos_ < len)
+      return false;
+    memcpy(data, this->data_.data() + this->pos_, len);
+    this->pos_ += len;
+    return true;
+  }
+
+ protected:
+  const std::string &data_;
+  size_t pos_{0};
+};
+
+// The parser of loop() before the chunked receive path, one state machine step per byte. handle_value_() is
+// replaced by counting the lines, decoding and publishing aren't part of the receive path.
+class BaselineParser {
+ public:
+  int parse(Uart *uart) {
+    int frames = 0;
+    while (uart->available()) {
+      uint8_t c;
+      uart->read_byte(&c);
+      if (this->state_ == 0) {
+        if ((c == '\r') || (c == '\n'))
+          continue;
+        this->label_.clear();
+        this->value_.clear();
+        this->state_ = 1;
+      }
+      if (this->state_ == 1) {
+        if (c == '\t')
+          this->state_ = 2;
+        else
+          this->label_.push_back(c);
+        continue;
+      }
+      if (this->state_ == 2) {
+        if (this->label_ == "Checksum") {
+          this->state_ = 0;
+          // The checksum is used as end of frame indicator
+          frames++;
+          continue;
+        }
+        if ((c == '\r') || (c == '\n')) {
+          this->handle_value_();
+          this->state_ = 0;
+        } else {
+          this->value_.push_back(c);
+        }
+      }
+    }
+    return frames;
+  }
+
+  size_t lines() const { return this->lines_; }
+
+ protected:
+  void handle_value_() { this->lines_ += this->label_.size() + this->value_.size() > 0; }
+
+  int state_{0};
+  std::string label_;
+  std::string value_;
+  size_t lines_{0};
+};
+
+// A block of an MPPT with load output, like the emulator sends it
+static std::string mppt_frame(int i) {
+  char block[512];
+  int len = snprintf(block, sizeof(block),
+                     "\r\nPID\t0xA053\r\nFW\t159\r\nSER#\tHQ2132QY2KR\r\nV\t%d\r\nI\t%d\r\nVPV\t%d\r\nPPV\t%d"
+                     "\r\nCS\t3\r\nMPPT\t2\r\nOR\t0x00000000\r\nERR\t0\r\nLOAD\tON\r\nIL\t300\r\nH19\t%d"
+                     "\r\nH20\t12\r\nH21\t85\r\nH22\t40\r\nH23\t120\r\nHSDS\t%d\r\nChecksum\t",
+                     12000 + i % 700, 500 + i % 300, 35000 + i % 900, 6 + i % 90, 1000 + i / 1000, i % 365);
+  uint8_t sum = 0;
+  for (int j = 0; j < len; j++)
+    sum += static_cast<uint8_t>(block[j]);
+  block[len++] = static_cast<char>(256 - sum);
+  return std::string(block, len);
+}
+
+// Hides the type of the UART from the optimizer, so the calls stay virtual like on the device
+static Uart *opaque(Uart *uart) {
+  asm volatile("" : "+r"(uart));
+  return uart;
+}
+
+static void report(const char *path, double ms, size_t bytes) {
+  printf("%-32s %8.1f ms %8.1f MB/s\n", path, ms, bytes / ms / 1000.0);
+}
+
+template<typename F> static double measure(F &&run) {
+  const auto start = std::chrono::steady_clock::now();
+  const int frames = run();
+  const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  if (frames < FRAMES - 1)
+    printf("  only %d of %d frames\n", frames, FRAMES);
+  return ms;
+}
+
+int main() {
+  std::string stream;
+  for (int i = 0; i < FRAMES; i++)
+    stream += mppt_frame(i);
+  printf("%d frames, %zu bytes\n", FRAMES, stream.size());
+
+  const double baseline_ms = measure([&stream] {
+    BufferUart buffer(stream);
+    BaselineParser parser;
+    return parser.parse(opaque(&buffer));
+  });
+
+  const double bytes_ms = measure([&stream] {
+    BufferUart buffer(stream);
+    Uart *uart = opaque(&buffer);
+    FrameAssembler assembler;
+    int frames = 0;
+    while (uart->available()) {
+      uint8_t c;
+      size_t consumed;
+      uart->read_byte(&c);
+      if (assembler.feed(&c, 1, &consumed))
+        frames++;
+    }
+    return frames;
+  });
+
+  const double chunks_ms = measure([&stream] {
+    BufferUart buffer(stream);
+    Uart *uart = opaque(&buffer);
+    FrameAssembler assembler;
+    int frames = 0;
+    uint8_t chunk[CHUNK_SIZE];
+    size_t len;
+    while ((len = std::min<size_t>(uart->available(), sizeof(chunk))) > 0) {
+      uart->read_array(chunk, len);
+      const uint8_t *pos = chunk;
+      while (len > 0) {
+        size_t consumed;
+        if (assembler.feed(pos, len, &consumed))
+          frames++;
+        pos += consumed;
+        len -= consumed;
+      }
+    }
+    return frames;
+  });
+
+  report("baseline parser, read_byte()", baseline_ms, stream.size());
+  report("frame assembler, read_byte()", bytes_ms, stream.size());
+  report("frame assembler, read_array()", chunks_ms, stream.size());
+  printf("chunked assembler vs. baseline parser: %.2fx\n", baseline_ms / chunks_ms);
+  printf("chunked vs. byte at a time (same assembler): %.2fx\n", bytes_ms / chunks_ms);
+  return 0;
+}
@@ -0,0 +1,141 @@
+// Host test of the RX task hand-off: a receiver thread feeds the frame assembler in chunks of random size and
+// pushes the frames into the SPSC ring, the main thread pops and checks them like loop() does.
+//
+//   g++ -O2 -std=gnu++17 -pthread -Icomponents benchmarks/rx_handoff_test.cpp components/victron/frame_assembler.cpp -o rx_handoff_test
+//
+// Every frame carries a sequence number. The first run blocks the receiver while the ring is full and expects
+// every frame in order, the second one drops frames like the RX task does and expects the dropped ones to be
+// counted. HEX messages and a corrupted frame are mixed into the stream.
+
+#include "victron/frame_assembler.h"
+#include "victron/spsc_ring.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+
+using esphome::victron::FrameAssembler;
+using esphome::victron::RawFrame;
+using esphome::victron::SpscRing;
+
+static const int FRAMES = 20000;
+// Every CORRUPT_EVERY-th frame is sent with a wrong checksum
+static const int CORRUPT_EVERY = 997;
+static const size_t MAX_CHUNK_SIZE = 64;
+
+static std::string checksummed(const std::string &block) {
+  uint8_t sum = 0;
+  for (const char c : block)
+    sum += static_cast<uint8_t>(c);
+  return block + static_cast<char>(256 - sum);
+}
+
+static std::string make_stream() {
+  std::string stream;
+  char block[256];
+  for (int i = 0; i < FRAMES; i++) {
+    snprintf(block, sizeof(block), "\r\nPID\t0xA053\r\nV\t%d\r\nSEQ\t%d\r\nCS\t3\r\nChecksum\t", 12000 + i % 700, i);
+    std::string frame = checksummed(block);
+    if (i % CORRUPT_EVERY == CORRUPT_EVERY - 1)
+      frame[8] ^= 1;
+    // A HEX message in the middle of a frame and one between two frames
+    if (i % 10 == 0)
+      frame.insert(frame.find("SEQ"), ":A0102000543\n");
+    if (i % 7 == 0)
+      frame += ":A0102000543\n";
+    stream += frame;
+  }
+  return stream;
+}
+
+static int sequence_of(const RawFrame &frame) {
+  for (uint8_t i = 0; i < frame.num_fields; i++) {
+    if (strcmp(frame.fields[i].label, "SEQ") == 0)
+      return atoi(frame.fields[i].value);
+  }
+  return -1;
+}
+
+static int run(const std::string &stream, bool lossless) {
+  SpscRing<RawFrame, 4> queue;
+  std::atomic<bool> done{false};
+  uint32_t dropped = 0;
+  uint32_t checksum_errors = 0;
+
+  std::thread receiver([&] {
+    FrameAssembler assembler;
+    assembler.idle();
+    std::mt19937 random(42);
+    size_t pos = 0;
+    while (pos < stream.size()) {
+      size_t len = std::min<size_t>(random() % MAX_CHUNK_SIZE + 1, stream.size() - pos);
+      const uint8_t *chunk = reinterpret_cast<const uint8_t *>(stream.data()) + pos;
+      pos += len;
+      while (len > 0) {
+        size_t consumed;
+        const bool complete = assembler.feed(chunk, len, &consumed);
+        chunk += consumed;
+        len -= consumed;
+        if (!complete)
+          continue;
+        while (!queue.push(assembler.frame())) {
+          if (!lossless) {
+            dropped++;
+            break;
+          }
+          std::this_thread::yield();
+        }
+      }
+    }
+    checksum_errors = assembler.checksum_errors();
+    done.store(true, std::memory_order_release);
+  });
+
+  RawFrame frame;
+  int received = 0;
+  int last = -1;
+  int failures = 0;
+  while (true) {
+    // Checked before popping, so the frames pushed before the receiver finished are all popped
+    const bool finished = done.load(std::memory_order_acquire);
+    if (!queue.pop(frame)) {
+      if (finished)
+        break;
+      std::this_thread::yield();
+      continue;
+    }
+    const int sequence = sequence_of(frame);
+    if (frame.num_fields != 4 || sequence <= last || sequence % CORRUPT_EVERY == CORRUPT_EVERY - 1) {
+      printf("  unexpected frame %d after %d (%u fields)\n", sequence, last, frame.num_fields);
+      failures++;
+    } else if (lossless && sequence != last + 1 && sequence != last + 2) {
+      // Only the corrupted frame may be missing
+      printf("  frame %d follows %d\n", sequence, last);
+      failures++;
+    }
+    last = sequence;
+    received++;
+  }
+  receiver.join();
+
+  const int expected = FRAMES - FRAMES / CORRUPT_EVERY;
+  printf("%s: %d frames received, %u dropped, %u checksum errors\n", lossless ? "blocking" : "dropping", received,
+         dropped, checksum_errors);
+  if (received + (int) dropped != expected || (lossless && dropped != 0) ||
+      checksum_errors != (uint32_t) (FRAMES / CORRUPT_EVERY)) {
+    printf("  expected %d frames and %d checksum errors\n", expected, FRAMES / CORRUPT_EVERY);
+    failures++;
+  }
+  return failures;
+}
+
+int main() {
+  const std::string stream = make_stream();
+  const int failures = run(stream, true) + run(stream, false);
+  printf("%s\n", failures == 0 ? "PASSED" : "FAILED");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,34 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import uart
+from esphome.const import CONF_BAUD_RATE, CONF_ID
+
+AUTO_LOAD = ["uart"]
+
+MULTI_CONF = True
+
+host_uart_ns = cg.esphome_ns.namespace("host_uart")
+HostUARTComponent = host_uart_ns.class_(
+    "HostUARTComponent", uart.UARTComponent, cg.Component
+)
+
+CONF_DEVICE = "device"
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(HostUARTComponent),
+            cv.Required(CONF_DEVICE): cv.string,
+            cv.Optional(CONF_BAUD_RATE, default=19200): cv.int_range(min=1),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.only_on(["host"]),
+)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    cg.add(var.set_device(config[CONF_DEVICE]))
+    cg.add(var.set_baud_rate(config[CONF_BAUD_RATE]))
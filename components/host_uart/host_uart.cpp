@@ -0,0 +1,138 @@
+#include "host_uart.h"
+
+#ifdef USE_HOST
+
+#include "esphome/core/log.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace esphome {
+namespace host_uart {
+
+static const char *const TAG = "host_uart";
+// ms, max. time to wait for a full output buffer
+static const int WRITE_TIMEOUT = 100;
+
+static speed_t baud_rate_to_speed(uint32_t baud_rate) {
+  switch (baud_rate) {
+    case 9600:
+      return B9600;
+    case 19200:
+      return B19200;
+    case 38400:
+      return B38400;
+    case 57600:
+      return B57600;
+    case 115200:
+      return B115200;
+    default:
+      return B0;
+  }
+}
+
+void HostUARTComponent::setup() {
+  this->fd_ = ::open(this->device_.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (this->fd_ < 0) {
+    ESP_LOGE(TAG, "Unable to open %s: %s", this->device_.c_str(), strerror(errno));
+    this->mark_failed();
+    return;
+  }
+
+  struct termios tty;
+  if (tcgetattr(this->fd_, &tty) == 0) {
+    cfmakeraw(&tty);
+    // A pty ignores the line speed
+    const speed_t speed = baud_rate_to_speed(this->baud_rate_);
+    if (speed != B0)
+      cfsetspeed(&tty, speed);
+    tcsetattr(this->fd_, TCSANOW, &tty);
+  }
+}
+
+void HostUARTComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Host UART:");
+  ESP_LOGCONFIG(TAG, "  Device: %s", this->device_.c_str());
+  ESP_LOGCONFIG(TAG, "  Baud Rate: %u baud", this->baud_rate_);
+}
+
+void HostUARTComponent::fill_() {
+  if (this->fd_ < 0)
+    return;
+
+  if (this->head_ == this->tail_) {
+    this->head_ = 0;
+    this->tail_ = 0;
+  } else if (this->tail_ == sizeof(this->buffer_) && this->head_ > 0) {
+    memmove(this->buffer_, this->buffer_ + this->head_, this->tail_ - this->head_);
+    this->tail_ -= this->head_;
+    this->head_ = 0;
+  }
+
+  const ssize_t len = ::read(this->fd_, this->buffer_ + this->tail_, sizeof(this->buffer_) - this->tail_);
+  if (len > 0)
+    this->tail_ += len;
+}
+
+int HostUARTComponent::available() {
+  this->fill_();
+  return this->tail_ - this->head_;
+}
+
+bool HostUARTComponent::peek_byte(uint8_t *data) {
+  if (this->available() == 0)
+    return false;
+
+  *data = this->buffer_[this->head_];
+  return true;
+}
+
+bool HostUARTComponent::read_array(uint8_t *data, size_t len) {
+  if (static_cast<size_t>(this->available()) < len)
+    return false;
+
+  memcpy(data, this->buffer_ + this->head_, len);
+  this->head_ += len;
+  return true;
+}
+
+void HostUARTComponent::write_array(const uint8_t *data, size_t len) {
+  if (this->fd_ < 0)
+    return;
+
+  while (len > 0) {
+    const ssize_t written = ::write(this->fd_, data, len);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      if (errno == EAGAIN) {
+        // The output buffer of the tty is full, wait until it drained
+        struct pollfd pfd = {this->fd_, POLLOUT, 0};
+        const int ready = ::poll(&pfd, 1, WRITE_TIMEOUT);
+        if (ready > 0 || (ready < 0 && errno == EINTR))
+          continue;
+        if (ready == 0) {
+          ESP_LOGW(TAG, "Write to %s timed out", this->device_.c_str());
+          return;
+        }
+      }
+      ESP_LOGW(TAG, "Write to %s failed: %s", this->device_.c_str(), strerror(errno));
+      return;
+    }
+    data += written;
+    len -= written;
+  }
+}
+
+void HostUARTComponent::flush() {
+  if (this->fd_ >= 0)
+    tcdrain(this->fd_);
+}
+
+}  // namespace host_uart
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_HOST
+
+#include "esphome/core/component.h"
+#include "esphome/components/uart/uart.h"
+
+namespace esphome {
+namespace host_uart {
+
+/// UART of the Linux host platform backed by a tty device, e.g. a pty of the VE.Direct emulator or a
+/// USB serial adapter.
+class HostUARTComponent : public uart::UARTComponent, public Component {
+ public:
+  void set_device(const std::string &device) { this->device_ = device; }
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::BUS; }
+
+  void write_array(const uint8_t *data, size_t len) override;
+  bool peek_byte(uint8_t *data) override;
+  bool read_array(uint8_t *data, size_t len) override;
+  int available() override;
+  void flush() override;
+
+ protected:
+  void check_logger_conflict() override {}
+  void fill_();
+
+  std::string device_;
+  int fd_{-1};
+  uint8_t buffer_[256];
+  size_t head_{0};
+  size_t tail_{0};
+};
+
+}  // namespace host_uart
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -1,7 +1,18 @@
+from esphome import automation
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import uart
-from esphome.const import CONF_ID, CONF_THROTTLE
+from esphome.components import binary_sensor, sensor, text_sensor, uart
+from esphome.const import (
+    CONF_BINARY_SENSOR,
+    CONF_ID,
+    CONF_OFFSET,
+    CONF_SENSOR,
+    CONF_TEXT_SENSOR,
+    CONF_THROTTLE,
+    CONF_TRIGGER_ID,
+    CONF_TYPE,
+    CONF_UPDATE_INTERVAL,
+)
 
 AUTO_LOAD = ["binary_sensor", "sensor", "text_sensor"]
 
@@ -13,13 +24,99 @@ MULTI_CONF = True
 
 victron_ns = cg.esphome_ns.namespace("victron")
 VictronComponent = victron_ns.class_("VictronComponent", uart.UARTDevice, cg.Component)
+Frame = victron_ns.struct("Frame")
+FieldType = victron_ns.enum("FieldType")
+FrameTrigger = victron_ns.class_(
+    "FrameTrigger", automation.Trigger.template(Frame.operator("ref").operator("const"))
+)
+DumpTraceAction = victron_ns.class_("DumpTraceAction", automation.Action)
 
 CONF_VICTRON_ID = "victron_id"
+CONF_RX_TASK = "rx_task"
+CONF_IDLE_POLL_INTERVAL = "idle_poll_interval"
+CONF_FAST_ALARMS = "fast_alarms"
+CONF_HEARTBEAT = "heartbeat"
+CONF_PUBLISH_BUDGET = "publish_budget"
+CONF_ON_FRAME = "on_frame"
+CONF_CUSTOM_FIELDS = "custom_fields"
+CONF_LABEL = "label"
+CONF_SCALE = "scale"
+CONF_TRACE = "trace"
+
+FIELD_TYPES = {
+    "int": FieldType.TYPE_INT,
+    "hex": FieldType.TYPE_HEX,
+}
+
+# Entities with an update interval of their own are published by the scheduler of the hub
+UPDATE_INTERVAL_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_UPDATE_INTERVAL): cv.positive_time_period_milliseconds,
+    }
+)
+
+# Labels of the protocol are up to 9 characters long
+CUSTOM_FIELD_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_LABEL): cv.All(cv.string_strict, cv.Length(min=1, max=9)),
+    }
+)
+
+# value * scale + offset
+NUMERIC_CUSTOM_FIELD_SCHEMA = CUSTOM_FIELD_SCHEMA.extend(
+    {
+        cv.Optional(CONF_SCALE, default=1.0): cv.float_,
+        cv.Optional(CONF_OFFSET, default=0.0): cv.float_,
+        cv.Required(CONF_SENSOR): sensor.sensor_schema().extend(UPDATE_INTERVAL_SCHEMA),
+    }
+)
+
+CUSTOM_FIELD_TYPED_SCHEMA = cv.typed_schema(
+    {
+        "int": NUMERIC_CUSTOM_FIELD_SCHEMA,
+        "hex": NUMERIC_CUSTOM_FIELD_SCHEMA,
+        "bool": CUSTOM_FIELD_SCHEMA.extend(
+            {
+                cv.Required(CONF_BINARY_SENSOR): binary_sensor.BINARY_SENSOR_SCHEMA.extend(
+                    {cv.GenerateID(): cv.declare_id(binary_sensor.BinarySensor)}
+                ).extend(UPDATE_INTERVAL_SCHEMA),
+            }
+        ),
+        "string": CUSTOM_FIELD_SCHEMA.extend(
+            {
+                cv.Required(CONF_TEXT_SENSOR): text_sensor.TEXT_SENSOR_SCHEMA.extend(
+                    {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
+                ).extend(UPDATE_INTERVAL_SCHEMA),
+            }
+        ),
+    },
+    lower=True,
+)
 
 CONFIG_SCHEMA = uart.UART_DEVICE_SCHEMA.extend(
     {
         cv.GenerateID(): cv.declare_id(VictronComponent),
         cv.Optional(CONF_THROTTLE, default="1s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_FAST_ALARMS, default=True): cv.boolean,
+        cv.Optional(CONF_HEARTBEAT, default="60s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_PUBLISH_BUDGET, default=0): cv.int_range(min=0, max=255),
+        cv.Optional(CONF_RX_TASK): cv.All(cv.boolean, cv.only_on_esp32),
+        # The RX buffer has to hold everything received during one interval (~2 bytes per ms)
+        cv.Optional(CONF_IDLE_POLL_INTERVAL, default="0ms"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(max=cv.TimePeriod(milliseconds=100)),
+        ),
+        # One bit per custom field in the masks of the decoder
+        cv.Optional(CONF_CUSTOM_FIELDS): cv.All(
+            cv.ensure_list(CUSTOM_FIELD_TYPED_SCHEMA), cv.Length(max=64)
+        ),
+        # Parser event trace for debugging, compiled in for all hubs
+        cv.Optional(CONF_TRACE, default=False): cv.boolean,
+        cv.Optional(CONF_ON_FRAME): automation.validate_automation(
+            {
+                cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(FrameTrigger),
+            }
+        ),
     }
 )
 
@@ -30,3 +127,59 @@ def to_code(config):
     yield uart.register_uart_device(var, config)
 
     cg.add(var.set_throttle(config[CONF_THROTTLE]))
+    cg.add(var.set_fast_alarms(config[CONF_FAST_ALARMS]))
+    cg.add(var.set_heartbeat(config[CONF_HEARTBEAT]))
+    cg.add(var.set_publish_budget(config[CONF_PUBLISH_BUDGET]))
+    cg.add(var.set_idle_poll_interval(config[CONF_IDLE_POLL_INTERVAL]))
+    if CONF_RX_TASK in config:
+        cg.add(var.set_rx_task(config[CONF_RX_TASK]))
+    if config[CONF_TRACE]:
+        cg.add_define("USE_VICTRON_TRACE")
+
+    for conf in config.get(CONF_CUSTOM_FIELDS, []):
+        label = conf[CONF_LABEL]
+        if conf[CONF_TYPE] in FIELD_TYPES:
+            entity = yield sensor.new_sensor(conf[CONF_SENSOR])
+            cg.add(
+                var.add_custom_field(
+                    label,
+                    FIELD_TYPES[conf[CONF_TYPE]],
+                    conf[CONF_SCALE],
+                    conf[CONF_OFFSET],
+                    entity,
+                )
+            )
+            entity_conf = conf[CONF_SENSOR]
+        elif conf[CONF_TYPE] == "bool":
+            entity_conf = conf[CONF_BINARY_SENSOR]
+            entity = cg.new_Pvariable(entity_conf[CONF_ID])
+            yield binary_sensor.register_binary_sensor(entity, entity_conf)
+            cg.add(var.add_custom_field(label, entity))
+        else:
+            entity_conf = conf[CONF_TEXT_SENSOR]
+            entity = cg.new_Pvariable(entity_conf[CONF_ID])
+            yield text_sensor.register_text_sensor(entity, entity_conf)
+            cg.add(var.add_custom_field(label, entity))
+        if CONF_UPDATE_INTERVAL in entity_conf:
+            cg.add(var.set_update_interval(entity, entity_conf[CONF_UPDATE_INTERVAL]))
+
+    for conf in config.get(CONF_ON_FRAME, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        yield automation.build_automation(
+            trigger, [(Frame.operator("ref").operator("const"), "frame")], conf
+        )
+
+
+@automation.register_action(
+    "victron.dump_trace",
+    DumpTraceAction,
+    automation.maybe_simple_id(
+        {
+            cv.GenerateID(): cv.use_id(VictronComponent),
+        }
+    ),
+)
+def dump_trace_to_code(config, action_id, template_arg, args):
+    parent = yield cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, parent)
+    yield var
@@ -1,9 +1,9 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import binary_sensor
-from esphome.const import CONF_ICON, CONF_ID, ICON_EMPTY
+from esphome.const import CONF_ICON, CONF_ID, CONF_UPDATE_INTERVAL, ICON_EMPTY
 
-from . import CONF_VICTRON_ID, VictronComponent
+from . import CONF_VICTRON_ID, UPDATE_INTERVAL_SCHEMA, VictronComponent
 
 DEPENDENCIES = ["victron"]
 
@@ -17,21 +17,18 @@ BINARY_SENSORS = [
     CONF_RELAY_STATE,
 ]
 
+BINARY_SENSOR_SCHEMA = binary_sensor.BINARY_SENSOR_SCHEMA.extend(
+    {
+        cv.GenerateID(): cv.declare_id(binary_sensor.BinarySensor),
+        cv.Optional(CONF_ICON, default=ICON_EMPTY): cv.icon,
+    }
+).extend(UPDATE_INTERVAL_SCHEMA)
+
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(CONF_VICTRON_ID): cv.use_id(VictronComponent),
-        cv.Optional(CONF_LOAD_STATE): binary_sensor.BINARY_SENSOR_SCHEMA.extend(
-            {
-                cv.GenerateID(): cv.declare_id(binary_sensor.BinarySensor),
-                cv.Optional(CONF_ICON, default=ICON_EMPTY): cv.icon,
-            }
-        ),
-        cv.Optional(CONF_RELAY_STATE): binary_sensor.BINARY_SENSOR_SCHEMA.extend(
-            {
-                cv.GenerateID(): cv.declare_id(binary_sensor.BinarySensor),
-                cv.Optional(CONF_ICON, default=ICON_EMPTY): cv.icon,
-            }
-        ),
+        cv.Optional(CONF_LOAD_STATE): BINARY_SENSOR_SCHEMA,
+        cv.Optional(CONF_RELAY_STATE): BINARY_SENSOR_SCHEMA,
     }
 )
 
@@ -44,3 +41,5 @@ def to_code(config):
             sens = cg.new_Pvariable(conf[CONF_ID])
             yield binary_sensor.register_binary_sensor(sens, conf)
             cg.add(getattr(hub, f"set_{key}_binary_sensor")(sens))
+            if CONF_UPDATE_INTERVAL in conf:
+                cg.add(hub.set_update_interval(sens, conf[CONF_UPDATE_INTERVAL]))
@@ -0,0 +1,170 @@
+#include "frame.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace esphome {
+namespace victron {
+
+struct FieldDescriptor {
+  const char *label;
+  FieldType type;
+};
+
+// Indexed by FrameField
+static const FieldDescriptor FIELDS[FIELD_COUNT] = {
+    {"V", TYPE_INT},        {"V2", TYPE_INT},        {"V3", TYPE_INT},       {"VS", TYPE_INT},
+    {"VM", TYPE_INT},       {"DM", TYPE_INT},        {"VPV", TYPE_INT},      {"PPV", TYPE_INT},
+    {"I", TYPE_INT},        {"I2", TYPE_INT},        {"I3", TYPE_INT},       {"IL", TYPE_INT},
+    {"LOAD", TYPE_ON_OFF},  {"T", TYPE_INT},         {"P", TYPE_INT},        {"CE", TYPE_INT},
+    {"SOC", TYPE_INT},      {"TTG", TYPE_INT},       {"Alarm", TYPE_ON_OFF}, {"RELAY", TYPE_ON_OFF},
+    {"AR", TYPE_INT},       {"OR", TYPE_HEX},        {"H1", TYPE_INT},       {"H2", TYPE_INT},
+    {"H3", TYPE_INT},       {"H4", TYPE_INT},        {"H5", TYPE_INT},       {"H6", TYPE_INT},
+    {"H7", TYPE_INT},       {"H8", TYPE_INT},        {"H9", TYPE_INT},       {"H10", TYPE_INT},
+    {"H11", TYPE_INT},      {"H12", TYPE_INT},       {"H13", TYPE_INT},      {"H14", TYPE_INT},
+    {"H15", TYPE_INT},      {"H16", TYPE_INT},       {"H17", TYPE_INT},      {"H18", TYPE_INT},
+    {"H19", TYPE_INT},      {"H20", TYPE_INT},       {"H21", TYPE_INT},      {"H22", TYPE_INT},
+    {"H23", TYPE_INT},      {"ERR", TYPE_INT},       {"CS", TYPE_INT},       {"BMV", TYPE_TEXT},
+    {"FW", TYPE_TEXT},      {"FWE", TYPE_TEXT},      {"PID", TYPE_HEX},      {"SER#", TYPE_TEXT},
+    {"HSDS", TYPE_INT},     {"MODE", TYPE_INT},      {"AC_OUT_V", TYPE_INT}, {"AC_OUT_I", TYPE_INT},
+    {"AC_OUT_S", TYPE_INT}, {"WARN", TYPE_INT},      {"MPPT", TYPE_INT},     {"MON", TYPE_INT},
+};
+
+static char *text_of(Frame &frame, FrameField field) {
+  switch (field) {
+    case FIELD_MODEL_DESCRIPTION:
+      return frame.model_description;
+    case FIELD_FIRMWARE:
+      return frame.firmware;
+    case FIELD_FIRMWARE_24BIT:
+      return frame.firmware_24bit;
+    default:
+      return frame.serial_number;
+  }
+}
+
+bool parse_value(FieldType type, const char *value, int32_t *decoded) {
+  // "---" marks a value which isn't available (yet)
+  if (value[0] == '-' && value[1] == '-')
+    return false;
+
+  switch (type) {
+    case TYPE_HEX:
+      *decoded = (int32_t) strtoul(value, nullptr, 16);
+      break;
+    case TYPE_ON_OFF:
+      *decoded = strcmp(value, "ON") == 0 ? 1 : strtol(value, nullptr, 10);
+      break;
+    default:
+      *decoded = strtol(value, nullptr, 10);
+      break;
+  }
+  return true;
+}
+
+// Index of the field with `label`, FIELD_COUNT if there is none
+static uint8_t find_field(const char *label) {
+  uint8_t index = 0;
+  while (index < FIELD_COUNT && strcmp(FIELDS[index].label, label) != 0)
+    index++;
+  // The relay label is spelled "Relay" by the BMVs
+  if (index == FIELD_COUNT && strcmp(label, "Relay") == 0)
+    index = FIELD_RELAY;
+  return index;
+}
+
+// Store a value of `type` as `number` or `text` and update its bit in `valid` and `changed`
+static void store_value(FieldType type, const char *value, uint64_t bit, int32_t *number, char *text, uint64_t *valid,
+                        uint64_t *changed) {
+  if (type == TYPE_TEXT) {
+    if (!(*valid & bit) || strcmp(text, value) != 0) {
+      strcpy(text, value);  // NOLINT(clang-analyzer-security.insecureAPI.strcpy)
+      *changed |= bit;
+    }
+    *valid |= bit;
+    return;
+  }
+
+  int32_t decoded;
+  if (!parse_value(type, value, &decoded)) {
+    if (*valid & bit)
+      *changed |= bit;
+    *valid &= ~bit;
+    *number = 0;
+    return;
+  }
+
+  if (!(*valid & bit) || *number != decoded) {
+    *number = decoded;
+    *changed |= bit;
+  }
+  *valid |= bit;
+}
+
+bool add_custom_slot(CustomFrame &custom, const char *label, FieldType type) {
+  if (custom.slots.size() >= MAX_CUSTOM_SLOTS)
+    return false;
+  CustomSlot slot{};
+  strncpy(slot.label, label, MAX_LABEL_LENGTH);
+  slot.type = type;
+  slot.field = static_cast<FrameField>(find_field(label));
+  if (slot.field != FIELD_COUNT)
+    custom.fields |= field_bit(slot.field);
+  custom.slots.push_back(slot);
+  return true;
+}
+
+void begin_block(Frame &frame, CustomFrame &custom) {
+  frame.changed = 0;
+  frame.received = 0;
+  custom.changed = 0;
+  custom.received = 0;
+}
+
+// Decode a value into the slots mapped to the field `index`, or to `label` if the field is unknown
+static bool decode_custom(CustomFrame &custom, uint8_t index, const RawField &field, uint32_t hash) {
+  bool found = false;
+  for (uint8_t i = 0; i < custom.slots.size(); i++) {
+    CustomSlot &slot = custom.slots[i];
+    if (slot.field != index || (index == FIELD_COUNT && strcmp(slot.label, field.label) != 0))
+      continue;
+    found = true;
+    const uint64_t bit = slot_bit(i);
+    custom.received |= bit;
+    if ((custom.memo_valid & bit) && slot.hash == hash)
+      continue;
+    slot.hash = hash;
+    custom.memo_valid |= bit;
+    store_value(slot.type, field.value, bit, &slot.value, slot.text, &custom.valid, &custom.changed);
+  }
+  return found;
+}
+
+bool decode_field(Frame &frame, FieldMemo &memo, CustomFrame &custom, const RawField &field) {
+  const uint8_t index = find_field(field.label);
+
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  for (const char *c = field.value; *c != '\0'; c++)
+    hash = (hash ^ (uint8_t) *c) * 16777619UL;
+
+  if (index == FIELD_COUNT)
+    return decode_custom(custom, index, field, hash);
+
+  const auto id = static_cast<FrameField>(index);
+  const uint64_t bit = field_bit(id);
+  if (custom.fields & bit)
+    decode_custom(custom, index, field, hash);
+  frame.received |= bit;
+
+  if ((memo.valid & bit) && memo.hashes[index] == hash)
+    return true;
+  memo.hashes[index] = hash;
+  memo.valid |= bit;
+
+  char *text = FIELDS[index].type == TYPE_TEXT ? text_of(frame, id) : nullptr;
+  store_value(FIELDS[index].type, field.value, bit, &frame.values[index], text, &frame.valid, &frame.changed);
+  return true;
+}
+
+}  // namespace victron
+}  // namespace esphome
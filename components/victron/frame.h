@@ -0,0 +1,158 @@
+#pragma once
+
+#include "frame_assembler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace victron {
+
+/// Fields of the VE.Direct text protocol, one per label.
+enum FrameField : uint8_t {
+  FIELD_BATTERY_VOLTAGE,                  // V     mV
+  FIELD_BATTERY_VOLTAGE_2,                // V2    mV
+  FIELD_BATTERY_VOLTAGE_3,                // V3    mV
+  FIELD_AUXILIARY_VOLTAGE,                // VS    mV
+  FIELD_MIDPOINT_VOLTAGE,                 // VM    mV
+  FIELD_MIDPOINT_DEVIATION,               // DM    per mill
+  FIELD_PANEL_VOLTAGE,                    // VPV   mV
+  FIELD_PANEL_POWER,                      // PPV   W
+  FIELD_BATTERY_CURRENT,                  // I     mA
+  FIELD_BATTERY_CURRENT_2,                // I2    mA
+  FIELD_BATTERY_CURRENT_3,                // I3    mA
+  FIELD_LOAD_CURRENT,                     // IL    mA
+  FIELD_LOAD_STATE,                       // LOAD  ON = 1, OFF = 0
+  FIELD_BATTERY_TEMPERATURE,              // T     °C
+  FIELD_INSTANTANEOUS_POWER,              // P     W
+  FIELD_CONSUMED_AMP_HOURS,               // CE    mAh
+  FIELD_STATE_OF_CHARGE,                  // SOC   per mill
+  FIELD_TIME_TO_GO,                       // TTG   min
+  FIELD_ALARM,                            // Alarm ON = 1, OFF = 0
+  FIELD_RELAY,                            // RELAY ON = 1, OFF = 0
+  FIELD_ALARM_REASON,                     // AR
+  FIELD_OFF_REASON,                       // OR
+  FIELD_DEEPEST_DISCHARGE,                // H1    mAh
+  FIELD_LAST_DISCHARGE,                   // H2    mAh
+  FIELD_AVERAGE_DISCHARGE,                // H3    mAh
+  FIELD_CHARGE_CYCLES,                    // H4
+  FIELD_FULL_DISCHARGES,                  // H5
+  FIELD_CUMULATIVE_AMP_HOURS,             // H6    mAh
+  FIELD_MIN_BATTERY_VOLTAGE,              // H7    mV
+  FIELD_MAX_BATTERY_VOLTAGE,              // H8    mV
+  FIELD_LAST_FULL_CHARGE,                 // H9    s
+  FIELD_AUTOMATIC_SYNCHRONIZATIONS,       // H10
+  FIELD_LOW_MAIN_VOLTAGE_ALARMS,          // H11
+  FIELD_HIGH_MAIN_VOLTAGE_ALARMS,         // H12
+  FIELD_LOW_AUXILIARY_VOLTAGE_ALARMS,     // H13
+  FIELD_HIGH_AUXILIARY_VOLTAGE_ALARMS,    // H14
+  FIELD_MIN_AUXILIARY_VOLTAGE,            // H15   mV
+  FIELD_MAX_AUXILIARY_VOLTAGE,            // H16   mV
+  FIELD_DISCHARGED_ENERGY,                // H17   0.01 kWh
+  FIELD_CHARGED_ENERGY,                   // H18   0.01 kWh
+  FIELD_YIELD_TOTAL,                      // H19   0.01 kWh
+  FIELD_YIELD_TODAY,                      // H20   0.01 kWh
+  FIELD_MAX_POWER_TODAY,                  // H21   W
+  FIELD_YIELD_YESTERDAY,                  // H22   0.01 kWh
+  FIELD_MAX_POWER_YESTERDAY,              // H23   W
+  FIELD_ERROR_CODE,                       // ERR
+  FIELD_CHARGING_MODE,                    // CS
+  FIELD_MODEL_DESCRIPTION,                // BMV   text
+  FIELD_FIRMWARE,                         // FW    text
+  FIELD_FIRMWARE_24BIT,                   // FWE   text
+  FIELD_PRODUCT_ID,                       // PID
+  FIELD_SERIAL_NUMBER,                    // SER#  text
+  FIELD_DAY_NUMBER,                       // HSDS
+  FIELD_DEVICE_MODE,                      // MODE
+  FIELD_AC_OUT_VOLTAGE,                   // AC_OUT_V  0.01 V
+  FIELD_AC_OUT_CURRENT,                   // AC_OUT_I  0.1 A
+  FIELD_AC_OUT_APPARENT_POWER,            // AC_OUT_S  VA
+  FIELD_WARNING_CODE,                     // WARN
+  FIELD_TRACKING_MODE,                    // MPPT
+  FIELD_MONITOR_MODE,                     // MON
+  FIELD_COUNT,
+};
+
+static_assert(FIELD_COUNT <= 64, "The field masks of a Frame are 64 bit wide");
+
+inline uint64_t field_bit(FrameField field) { return uint64_t(1) << field; }
+
+/// Encoding of a value.
+enum FieldType : uint8_t {
+  TYPE_INT,
+  TYPE_HEX,
+  TYPE_ON_OFF,
+  TYPE_TEXT,
+};
+
+/// Typed snapshot of the values received from a device, in the native integer units of the protocol.
+///
+/// Values persist across blocks, so both blocks of a BMV are available after the second one.
+struct Frame {
+  /// Value of every numeric field, 0 if not valid.
+  int32_t values[FIELD_COUNT];
+  /// Fields received with a value ("---" clears the bit).
+  uint64_t valid;
+  /// Fields of the last block whose value differs from the one before.
+  uint64_t changed;
+  /// Fields contained in the last block.
+  uint64_t received;
+
+  char model_description[MAX_VALUE_LENGTH + 1];
+  char firmware[MAX_VALUE_LENGTH + 1];
+  char firmware_24bit[MAX_VALUE_LENGTH + 1];
+  char serial_number[MAX_VALUE_LENGTH + 1];
+
+  bool has(FrameField field) const { return this->valid & field_bit(field); }
+  bool has_changed(FrameField field) const { return this->changed & field_bit(field); }
+  int32_t get(FrameField field) const { return this->values[field]; }
+};
+
+/// Hashes of the raw values of the last block. Decoding is skipped for values which didn't change.
+struct FieldMemo {
+  uint32_t hashes[FIELD_COUNT];
+  uint64_t valid;
+};
+
+/// A label mapped to an entity by the user, decoded like the fields of a Frame.
+struct CustomSlot {
+  char label[MAX_LABEL_LENGTH + 1];
+  FieldType type;
+  /// Field with the same label, FIELD_COUNT if the label is unknown to the decoder.
+  FrameField field;
+  int32_t value;
+  char text[MAX_VALUE_LENGTH + 1];
+  /// Hash of the raw value of the last block, like FieldMemo.
+  uint32_t hash;
+};
+
+/// The slots of the custom fields are bits of the masks.
+static const uint8_t MAX_CUSTOM_SLOTS = 64;
+
+/// Values of the custom fields, with masks like the ones of a Frame.
+struct CustomFrame {
+  std::vector<CustomSlot> slots;
+  uint64_t valid;
+  uint64_t changed;
+  uint64_t received;
+  /// Slots with a hash of the last raw value.
+  uint64_t memo_valid;
+  /// Fields which are also mapped to a slot.
+  uint64_t fields;
+};
+
+inline uint64_t slot_bit(uint8_t slot) { return uint64_t(1) << slot; }
+
+/// Parse a numeric value. Returns false if the value isn't available ("---").
+bool parse_value(FieldType type, const char *value, int32_t *decoded);
+/// Map `label` to the next slot of `custom`. Returns false if all slots are in use.
+bool add_custom_slot(CustomFrame &custom, const char *label, FieldType type);
+/// Start decoding the next block into `frame` and `custom`.
+void begin_block(Frame &frame, CustomFrame &custom);
+/// Decode one line of a block into `frame` and the slots of `custom` with the same label. Returns false for labels
+/// which are neither known nor mapped to a slot.
+bool decode_field(Frame &frame, FieldMemo &memo, CustomFrame &custom, const RawField &field);
+
+}  // namespace victron
+}  // namespace esphome
@@ -0,0 +1,195 @@
+#include "frame_assembler.h"
+#include <cstring>
+
+namespace esphome {
+namespace victron {
+
+void FrameAssembler::reset() {
+  this->frame_.num_fields = 0;
+  this->state_ = STATE_IDLE;
+  this->complete_ = false;
+  this->fingerprint_ = FNV_OFFSET_BASIS;
+  this->checksum_ = 0;
+  this->sync_ = SYNC_HUNTING;
+  this->lock_pending_ = true;
+}
+
+void FrameAssembler::idle() {
+  // While locked a pause in the middle of a frame is left to the timeout of the caller
+  if (this->sync_ != SYNC_HUNTING)
+    return;
+  this->reset();
+  this->sync_ = SYNC_VERIFYING;
+}
+
+void FrameAssembler::begin_field_() {
+  if (this->complete_) {
+    this->frame_.num_fields = 0;
+    this->complete_ = false;
+    this->fingerprint_ = FNV_OFFSET_BASIS;
+  }
+  // Lines beyond the capacity of a frame are parsed into a scratch field and dropped
+  this->field_ = this->frame_.num_fields < MAX_FRAME_FIELDS ? &this->frame_.fields[this->frame_.num_fields]
+                                                           : &this->discard_;
+  this->length_ = 0;
+}
+
+// Copy, fingerprint and checksum in one pass over the bytes of a label or value
+void FrameAssembler::absorb_(char *dest, uint8_t max_length, const uint8_t *first, const uint8_t *last) {
+  uint32_t hash = this->fingerprint_;
+  uint8_t checksum = this->checksum_;
+  uint8_t length = this->length_;
+  for (; first < last; first++) {
+    hash = (hash ^ *first) * FNV_PRIME;
+    checksum += *first;
+    // Characters beyond the protocol limit are dropped
+    if (length < max_length)
+      dest[length++] = *first;
+  }
+  this->fingerprint_ = hash;
+  this->checksum_ = checksum;
+  this->length_ = length;
+}
+
+// The separator at the end of a label or value
+void FrameAssembler::absorb_(uint8_t c) {
+  this->fingerprint_ = (this->fingerprint_ ^ c) * FNV_PRIME;
+  this->checksum_ += c;
+}
+
+// True if any byte of `word` equals the byte repeated in `pattern`
+static inline bool has_byte(uint32_t word, uint32_t pattern) {
+  const uint32_t x = word ^ pattern;
+  return ((x - 0x01010101UL) & ~x & 0x80808080UL) != 0;
+}
+
+// End of a value, or the start of a HEX message in the middle of it
+static const uint8_t *find_line_end(const uint8_t *pos, const uint8_t *end) {
+  // Word at a time until a word contains '\r', '\n' or ':'
+  while (end - pos >= 4) {
+    uint32_t word;
+    memcpy(&word, pos, sizeof(word));
+    if (has_byte(word, 0x0D0D0D0DUL) || has_byte(word, 0x0A0A0A0AUL) || has_byte(word, 0x3A3A3A3AUL))
+      break;
+    pos += 4;
+  }
+  while ((pos < end) && (*pos != '\r') && (*pos != '\n') && (*pos != ':'))
+    pos++;
+  return pos;
+}
+
+// End of a label, or the start of a HEX message in the middle of it
+static const uint8_t *find_label_end(const uint8_t *pos, const uint8_t *end) {
+  // Word at a time until a word contains '\t' or ':'
+  while (end - pos >= 4) {
+    uint32_t word;
+    memcpy(&word, pos, sizeof(word));
+    if (has_byte(word, 0x09090909UL) || has_byte(word, 0x3A3A3A3AUL))
+      break;
+    pos += 4;
+  }
+  while ((pos < end) && (*pos != '\t') && (*pos != ':'))
+    pos++;
+  return pos;
+}
+
+bool FrameAssembler::feed(const uint8_t *data, size_t len, size_t *consumed) {
+  const uint8_t *pos = data;
+  const uint8_t *end = data + len;
+  bool complete = false;
+
+  while ((pos < end) && !complete) {
+    // A HEX message may start anywhere, except for the checksum byte which can have any value
+    if ((*pos == ':') && (this->state_ != STATE_CHECKSUM) && (this->state_ != STATE_HEX)) {
+      this->hex_return_ = this->state_;
+      this->state_ = STATE_HEX;
+    }
+
+    switch (this->state_) {
+      case STATE_IDLE:
+        if ((*pos == '\r') || (*pos == '\n')) {
+          this->checksum_ += *pos++;
+          break;
+        }
+        this->begin_field_();
+        this->state_ = STATE_LABEL;
+        // fall through
+      case STATE_LABEL: {
+        const uint8_t *tab = find_label_end(pos, end);
+        if ((tab == end) || (*tab != '\t')) {
+          this->absorb_(this->field_->label, MAX_LABEL_LENGTH, pos, tab);
+          pos = tab;
+          break;
+        }
+        this->absorb_(this->field_->label, MAX_LABEL_LENGTH, pos, tab);
+        // Including the separator, "AB<tab>C" and "A<tab>BC" differ
+        this->absorb_(*tab);
+        pos = tab + 1;
+        this->field_->label[this->length_] = '\0';
+        // The checksum is used as end of frame indicator
+        this->state_ = (this->length_ == 8) && (memcmp(this->field_->label, "Checksum", 8) == 0) ? STATE_CHECKSUM
+                                                                                                 : STATE_VALUE;
+        this->length_ = 0;
+        break;
+      }
+      case STATE_VALUE: {
+        const uint8_t *eol = find_line_end(pos, end);
+        this->absorb_(this->field_->value, MAX_VALUE_LENGTH, pos, eol);
+        if ((eol == end) || (*eol == ':')) {
+          pos = eol;
+          break;
+        }
+        this->absorb_(*eol);
+        pos = eol + 1;
+        // Saves a pass through IDLE for the "\n" of "\r\n", which isn't part of the fingerprint
+        if ((pos < end) && (*pos == '\n'))
+          this->checksum_ += *pos++;
+        this->field_->value[this->length_] = '\0';
+        if (this->field_ != &this->discard_)
+          this->frame_.num_fields++;
+        this->state_ = STATE_IDLE;
+        break;
+      }
+      case STATE_CHECKSUM:
+        this->checksum_ += *pos++;
+        this->frame_.fingerprint = this->fingerprint_;
+        this->state_ = STATE_IDLE;
+        this->complete_ = true;
+        complete = true;
+        break;
+      case STATE_HEX: {
+        // HEX messages aren't part of the checksum of the text frame
+        const auto *eol = static_cast<const uint8_t *>(memchr(pos, '\n', end - pos));
+        pos = eol == nullptr ? end : eol + 1;
+        if (eol != nullptr)
+          this->state_ = this->hex_return_;
+        break;
+      }
+    }
+  }
+
+  if (complete) {
+    const bool valid = this->checksum_ == 0;
+    this->checksum_ = 0;
+    if (this->sync_ == SYNC_HUNTING) {
+      // Joined somewhere in the middle, the end of this frame is the first known boundary
+      this->sync_ = SYNC_VERIFYING;
+      complete = false;
+    } else if (!valid) {
+      // Trust the stream again after the next valid frame only
+      this->checksum_errors_++;
+      this->sync_ = SYNC_VERIFYING;
+      complete = false;
+    } else {
+      this->frame_.first = this->lock_pending_;
+      this->lock_pending_ = false;
+      this->sync_ = SYNC_LOCKED;
+    }
+  }
+
+  *consumed = pos - data;
+  return complete;
+}
+
+}  // namespace victron
+}  // namespace esphome
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace victron {
+
+// Limits of the VE.Direct text protocol
+static const uint8_t MAX_LABEL_LENGTH = 9;
+static const uint8_t MAX_VALUE_LENGTH = 33;
+// The largest block (MPPT with load output) carries ~20 lines
+static const uint8_t MAX_FRAME_FIELDS = 24;
+
+struct RawField {
+  char label[MAX_LABEL_LENGTH + 1];
+  char value[MAX_VALUE_LENGTH + 1];
+};
+
+/// One block of label/value lines terminated by a "Checksum" line.
+struct RawFrame {
+  /// FNV-1a hash of all labels and values, equal for byte-identical blocks.
+  uint32_t fingerprint;
+  /// First frame after start or reset(), not after re-verifying because of a checksum error.
+  bool first;
+  uint8_t num_fields;
+  RawField fields[MAX_FRAME_FIELDS];
+};
+
+/// Assembles the lines of the VE.Direct text protocol into complete frames.
+///
+/// After start and reset() the position in the data stream is unknown. The assembler hunts for a frame
+/// boundary (the end of a "Checksum" line or a pause), verifies the checksum of the next frame and is locked
+/// afterwards. Nothing is reported before. Async HEX messages (":...\n") are skipped, also in the middle of a
+/// frame.
+///
+/// Free of any ESPHome dependency so it can run in a dedicated RX task or on the host.
+class FrameAssembler {
+ public:
+  /// Feed a chunk of received bytes. Stops right after the end of a frame and returns true in that case if the
+  /// checksum of the frame is valid; the frame stays available via frame() until the next call to feed(). The
+  /// number of bytes used is stored in `consumed`, the caller feeds the rest of the chunk again.
+  bool feed(const uint8_t *data, size_t len, size_t *consumed);
+  /// Drop the partially received line and frame and hunt for the next frame boundary.
+  void reset();
+  /// The line has been silent for a while, which is a frame boundary.
+  void idle();
+  /// True once a frame with a valid checksum was received since the last reset().
+  bool locked() const { return this->sync_ == SYNC_LOCKED; }
+  /// True while a line or frame is partially received.
+  bool in_frame() const { return this->state_ != STATE_IDLE || (!this->complete_ && this->frame_.num_fields > 0); }
+  const RawFrame &frame() const { return this->frame_; }
+  /// Number of frames dropped because of an invalid checksum.
+  uint32_t checksum_errors() const { return this->checksum_errors_; }
+
+ protected:
+  static const uint32_t FNV_OFFSET_BASIS = 2166136261UL;
+  static const uint32_t FNV_PRIME = 16777619UL;
+
+  enum State : uint8_t {
+    STATE_IDLE,
+    STATE_LABEL,
+    STATE_VALUE,
+    STATE_CHECKSUM,
+    STATE_HEX,
+  };
+
+  enum Sync : uint8_t {
+    SYNC_HUNTING,
+    SYNC_VERIFYING,
+    SYNC_LOCKED,
+  };
+
+  void begin_field_();
+  void absorb_(char *dest, uint8_t max_length, const uint8_t *first, const uint8_t *last);
+  void absorb_(uint8_t c);
+
+  RawFrame frame_{};
+  RawField discard_{};
+  RawField *field_{nullptr};
+  uint32_t fingerprint_{FNV_OFFSET_BASIS};
+  uint32_t checksum_errors_{0};
+  // Sum of all bytes of the frame except HEX messages, 0 for a valid frame
+  uint8_t checksum_{0};
+  uint8_t length_{0};
+  State state_{STATE_IDLE};
+  // State to return to at the end of a HEX message
+  State hex_return_{STATE_IDLE};
+  Sync sync_{SYNC_HUNTING};
+  // The next valid frame is the first one since start or reset()
+  bool lock_pending_{true};
+  bool complete_{false};
+};
+
+}  // namespace victron
+}  // namespace esphome
@@ -3,6 +3,7 @@ import esphome.config_validation as cv
 from esphome.components import sensor
 from esphome.const import (
     CONF_BATTERY_VOLTAGE,
+    CONF_UPDATE_INTERVAL,
     DEVICE_CLASS_CURRENT,
     DEVICE_CLASS_EMPTY,
     DEVICE_CLASS_POWER,
@@ -25,7 +26,7 @@ from esphome.const import (
     UNIT_WATT_HOURS,
 )
 
-from . import CONF_VICTRON_ID, VictronComponent
+from . import CONF_VICTRON_ID, UPDATE_INTERVAL_SCHEMA, VictronComponent
 
 DEPENDENCIES = ["victron"]
 
@@ -82,6 +83,12 @@ CONF_MAX_AUXILIARY_BATTERY_VOLTAGE = "max_auxiliary_battery_voltage"
 CONF_AMOUNT_OF_DISCHARGED_ENERGY = "amount_of_discharged_energy"
 CONF_AMOUNT_OF_CHARGED_ENERGY = "amount_of_charged_energy"
 
+# Derived from the values of a frame
+CONF_BATTERY_POWER = "battery_power"
+CONF_CHARGER_EFFICIENCY = "charger_efficiency"
+CONF_LOAD_POWER = "load_power"
+CONF_MIDPOINT_BALANCE = "midpoint_balance"
+
 UNIT_AMPERE_HOURS = "Ah"
 
 SENSORS = [
@@ -135,6 +142,11 @@ SENSORS = [
     CONF_MAX_AUXILIARY_BATTERY_VOLTAGE,
     CONF_AMOUNT_OF_DISCHARGED_ENERGY,
     CONF_AMOUNT_OF_CHARGED_ENERGY,
+    #
+    CONF_BATTERY_POWER,
+    CONF_CHARGER_EFFICIENCY,
+    CONF_LOAD_POWER,
+    CONF_MIDPOINT_BALANCE,
 ]
 
 
@@ -146,298 +158,326 @@ CONFIG_SCHEMA = cv.Schema(
             icon=ICON_POWER,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_POWER,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_MAX_POWER_TODAY): sensor.sensor_schema(
             unit_of_measurement=UNIT_WATT,
             icon=ICON_POWER,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_POWER,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_YIELD_TOTAL): sensor.sensor_schema(
             unit_of_measurement=UNIT_WATT_HOURS,
             icon=ICON_POWER,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_POWER,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_YIELD_YESTERDAY): sensor.sensor_schema(
             unit_of_measurement=UNIT_WATT_HOURS,
             icon=ICON_POWER,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_POWER,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_YIELD_TODAY): sensor.sensor_schema(
             unit_of_measurement=UNIT_WATT_HOURS,
             icon=ICON_POWER,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_POWER,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_PANEL_VOLTAGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_VOLT,
             icon=ICON_FLASH,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_VOLTAGE,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_PANEL_POWER): sensor.sensor_schema(
             unit_of_measurement=UNIT_WATT,
             icon=ICON_POWER,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_POWER,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_BATTERY_VOLTAGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_VOLT,
             icon=ICON_FLASH,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_VOLTAGE,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_BATTERY_VOLTAGE_2): sensor.sensor_schema(
             unit_of_measurement=UNIT_VOLT,
             icon=ICON_FLASH,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_VOLTAGE,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_BATTERY_VOLTAGE_3): sensor.sensor_schema(
             unit_of_measurement=UNIT_VOLT,
             icon=ICON_FLASH,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_VOLTAGE,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_AUXILIARY_BATTERY_VOLTAGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_VOLT,
             icon=ICON_FLASH,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_VOLTAGE,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_MIDPOINT_VOLTAGE_OF_THE_BATTERY_BANK): sensor.sensor_schema(
             unit_of_measurement=UNIT_VOLT,
             icon=ICON_FLASH,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_VOLTAGE,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_MIDPOINT_DEVIATION_OF_THE_BATTERY_BANK): sensor.sensor_schema(
             unit_of_measurement=UNIT_PERCENT,
             icon=ICON_PERCENT,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_BATTERY_CURRENT): sensor.sensor_schema(
             unit_of_measurement=UNIT_AMPERE,
             icon=ICON_CURRENT_AC,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_CURRENT,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_BATTERY_CURRENT_2): sensor.sensor_schema(
             unit_of_measurement=UNIT_AMPERE,
             icon=ICON_CURRENT_AC,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_CURRENT,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_BATTERY_CURRENT_3): sensor.sensor_schema(
             unit_of_measurement=UNIT_AMPERE,
             icon=ICON_CURRENT_AC,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_CURRENT,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_AC_OUT_VOLTAGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_VOLT,
             icon=ICON_FLASH,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_VOLTAGE,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_AC_OUT_CURRENT): sensor.sensor_schema(
             unit_of_measurement=UNIT_AMPERE,
             icon=ICON_CURRENT_AC,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_CURRENT,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_AC_OUT_APPARENT_POWER): sensor.sensor_schema(
             unit_of_measurement=UNIT_WATT,
             icon=ICON_POWER,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_POWER,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_DAY_NUMBER): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_CHARGING_MODE_ID): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_ERROR_CODE): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_WARNING_CODE): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_TRACKING_MODE_ID): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_DEVICE_MODE_ID): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_LOAD_CURRENT): sensor.sensor_schema(
             unit_of_measurement=UNIT_AMPERE,
             icon=ICON_CURRENT_AC,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_CURRENT,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_BATTERY_TEMPERATURE): sensor.sensor_schema(
             unit_of_measurement=UNIT_CELSIUS,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_TEMPERATURE,
             state_class=STATE_CLASS_MEASUREMENT,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_INSTANTANEOUS_POWER): sensor.sensor_schema(
             unit_of_measurement=UNIT_WATT,
             icon=ICON_POWER,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_POWER,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_CONSUMED_AMP_HOURS): sensor.sensor_schema(
             unit_of_measurement=UNIT_AMPERE_HOURS,
             icon=ICON_EMPTY,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_EMPTY,
             state_class=STATE_CLASS_MEASUREMENT,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_STATE_OF_CHARGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_PERCENT,
             icon=ICON_PERCENT,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_TIME_TO_GO): sensor.sensor_schema(
             unit_of_measurement=UNIT_MINUTE,
             icon=ICON_TIMELAPSE,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_DEPTH_OF_THE_DEEPEST_DISCHARGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_AMPERE,
             icon=ICON_CURRENT_AC,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_CURRENT,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_DEPTH_OF_THE_LAST_DISCHARGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_AMPERE,
             icon=ICON_CURRENT_AC,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_CURRENT,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_DEPTH_OF_THE_AVERAGE_DISCHARGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_AMPERE,
             icon=ICON_CURRENT_AC,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_CURRENT,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_NUMBER_OF_CHARGE_CYCLES): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_NUMBER_OF_FULL_DISCHARGES): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_CUMULATIVE_AMP_HOURS_DRAWN): sensor.sensor_schema(
             unit_of_measurement=UNIT_AMPERE_HOURS,
             icon=ICON_EMPTY,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_EMPTY,
             state_class=STATE_CLASS_MEASUREMENT,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_MIN_BATTERY_VOLTAGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_VOLT,
             icon=ICON_FLASH,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_VOLTAGE,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_MAX_BATTERY_VOLTAGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_VOLT,
             icon=ICON_FLASH,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_VOLTAGE,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_LAST_FULL_CHARGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_MINUTE,
             icon=ICON_TIMELAPSE,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_NUMBER_OF_AUTOMATIC_SYNCHRONIZATIONS): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_NUMBER_OF_LOW_MAIN_VOLTAGE_ALARMS): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_NUMBER_OF_HIGH_MAIN_VOLTAGE_ALARMS): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_NUMBER_OF_LOW_AUXILIARY_VOLTAGE_ALARMS): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_NUMBER_OF_HIGH_AUXILIARY_VOLTAGE_ALARMS): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             icon=ICON_EMPTY,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_EMPTY,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_MIN_AUXILIARY_BATTERY_VOLTAGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_VOLT,
             icon=ICON_FLASH,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_VOLTAGE,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_MAX_AUXILIARY_BATTERY_VOLTAGE): sensor.sensor_schema(
             unit_of_measurement=UNIT_VOLT,
             icon=ICON_FLASH,
             accuracy_decimals=3,
             device_class=DEVICE_CLASS_VOLTAGE,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_AMOUNT_OF_DISCHARGED_ENERGY): sensor.sensor_schema(
             unit_of_measurement=UNIT_WATT_HOURS,
             icon=ICON_POWER,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_POWER,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
         cv.Optional(CONF_AMOUNT_OF_CHARGED_ENERGY): sensor.sensor_schema(
             unit_of_measurement=UNIT_WATT_HOURS,
             icon=ICON_POWER,
             accuracy_decimals=0,
             device_class=DEVICE_CLASS_POWER,
-        ),
+        ).extend(UPDATE_INTERVAL_SCHEMA),
+        cv.Optional(CONF_BATTERY_POWER): sensor.sensor_schema(
+            unit_of_measurement=UNIT_WATT,
+            icon=ICON_POWER,
+            accuracy_decimals=1,
+            device_class=DEVICE_CLASS_POWER,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ).extend(UPDATE_INTERVAL_SCHEMA),
+        cv.Optional(CONF_CHARGER_EFFICIENCY): sensor.sensor_schema(
+            unit_of_measurement=UNIT_PERCENT,
+            icon=ICON_PERCENT,
+            accuracy_decimals=1,
+            device_class=DEVICE_CLASS_EMPTY,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ).extend(UPDATE_INTERVAL_SCHEMA),
+        cv.Optional(CONF_LOAD_POWER): sensor.sensor_schema(
+            unit_of_measurement=UNIT_WATT,
+            icon=ICON_POWER,
+            accuracy_decimals=1,
+            device_class=DEVICE_CLASS_POWER,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ).extend(UPDATE_INTERVAL_SCHEMA),
+        cv.Optional(CONF_MIDPOINT_BALANCE): sensor.sensor_schema(
+            unit_of_measurement=UNIT_VOLT,
+            icon=ICON_FLASH,
+            accuracy_decimals=3,
+            device_class=DEVICE_CLASS_VOLTAGE,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ).extend(UPDATE_INTERVAL_SCHEMA),
     }
 )
 
@@ -449,3 +489,5 @@ def to_code(config):
             conf = config[key]
             sens = yield sensor.new_sensor(conf)
             cg.add(getattr(hub, f"set_{key}_sensor")(sens))
+            if CONF_UPDATE_INTERVAL in conf:
+                cg.add(hub.set_update_interval(sens, conf[CONF_UPDATE_INTERVAL]))
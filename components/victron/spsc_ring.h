@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace victron {
+
+/// Lock-free single-producer/single-consumer ring of fixed-size records.
+///
+/// One thread may call push() and another one pop() concurrently. Capacity must be a power of two;
+/// all slots are usable because head and tail are free-running counters.
+template<typename T, size_t N> class SpscRing {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+ public:
+  /// Copy a record into the ring. Returns false (and drops the record) if the ring is full.
+  bool push(const T &item) {
+    const uint32_t head = this->head_.load(std::memory_order_relaxed);
+    if (head - this->tail_.load(std::memory_order_acquire) >= N)
+      return false;
+    this->items_[head & (N - 1)] = item;
+    this->head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Copy the oldest record out of the ring. Returns false if the ring is empty.
+  bool pop(T &item) {
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail == this->head_.load(std::memory_order_acquire))
+      return false;
+    item = this->items_[tail & (N - 1)];
+    this->tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const {
+    return this->tail_.load(std::memory_order_acquire) == this->head_.load(std::memory_order_acquire);
+  }
+
+ protected:
+  T items_[N];
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+};
+
+}  // namespace victron
+}  // namespace esphome
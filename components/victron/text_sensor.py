@@ -1,9 +1,9 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import text_sensor
-from esphome.const import CONF_ID
+from esphome.const import CONF_ID, CONF_UPDATE_INTERVAL
 
-from . import CONF_VICTRON_ID, VictronComponent
+from . import CONF_VICTRON_ID, UPDATE_INTERVAL_SCHEMA, VictronComponent
 
 DEPENDENCIES = ["victron"]
 
@@ -37,43 +37,35 @@ TEXT_SENSORS = [
     CONF_MODEL_DESCRIPTION,
 ]
 
+# Text tables compiled in only if one of their text sensors is configured
+TEXT_TABLE_DEFINES = {
+    CONF_CHARGING_MODE: "USE_VICTRON_CHARGING_MODE_TEXT",
+    CONF_ERROR: "USE_VICTRON_ERROR_TEXT",
+    CONF_ALARM_REASON: "USE_VICTRON_ERROR_TEXT",
+    CONF_WARNING: "USE_VICTRON_WARNING_TEXT",
+    CONF_TRACKING_MODE: "USE_VICTRON_TRACKING_MODE_TEXT",
+    CONF_DEVICE_MODE: "USE_VICTRON_DEVICE_MODE_TEXT",
+    CONF_DEVICE_TYPE: "USE_VICTRON_DEVICE_TYPE_TEXT",
+}
+
+TEXT_SENSOR_SCHEMA = text_sensor.TEXT_SENSOR_SCHEMA.extend(
+    {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
+).extend(UPDATE_INTERVAL_SCHEMA)
 
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(CONF_VICTRON_ID): cv.use_id(VictronComponent),
-        cv.Optional(CONF_CHARGING_MODE): text_sensor.TEXT_SENSOR_SCHEMA.extend(
-            {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
-        ),
-        cv.Optional(CONF_ERROR): text_sensor.TEXT_SENSOR_SCHEMA.extend(
-            {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
-        ),
-        cv.Optional(CONF_WARNING): text_sensor.TEXT_SENSOR_SCHEMA.extend(
-            {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
-        ),
-        cv.Optional(CONF_TRACKING_MODE): text_sensor.TEXT_SENSOR_SCHEMA.extend(
-            {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
-        ),
-        cv.Optional(CONF_DEVICE_MODE): text_sensor.TEXT_SENSOR_SCHEMA.extend(
-            {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
-        ),
-        cv.Optional(CONF_FIRMWARE_VERSION): text_sensor.TEXT_SENSOR_SCHEMA.extend(
-            {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
-        ),
-        cv.Optional(CONF_DEVICE_TYPE): text_sensor.TEXT_SENSOR_SCHEMA.extend(
-            {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
-        ),
-        cv.Optional(CONF_SERIAL_NUMBER): text_sensor.TEXT_SENSOR_SCHEMA.extend(
-            {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
-        ),
-        cv.Optional(CONF_ALARM_CONDITION_ACTIVE): text_sensor.TEXT_SENSOR_SCHEMA.extend(
-            {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
-        ),
-        cv.Optional(CONF_ALARM_REASON): text_sensor.TEXT_SENSOR_SCHEMA.extend(
-            {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
-        ),
-        cv.Optional(CONF_MODEL_DESCRIPTION): text_sensor.TEXT_SENSOR_SCHEMA.extend(
-            {cv.GenerateID(): cv.declare_id(text_sensor.TextSensor)}
-        ),
+        cv.Optional(CONF_CHARGING_MODE): TEXT_SENSOR_SCHEMA,
+        cv.Optional(CONF_ERROR): TEXT_SENSOR_SCHEMA,
+        cv.Optional(CONF_WARNING): TEXT_SENSOR_SCHEMA,
+        cv.Optional(CONF_TRACKING_MODE): TEXT_SENSOR_SCHEMA,
+        cv.Optional(CONF_DEVICE_MODE): TEXT_SENSOR_SCHEMA,
+        cv.Optional(CONF_FIRMWARE_VERSION): TEXT_SENSOR_SCHEMA,
+        cv.Optional(CONF_DEVICE_TYPE): TEXT_SENSOR_SCHEMA,
+        cv.Optional(CONF_SERIAL_NUMBER): TEXT_SENSOR_SCHEMA,
+        cv.Optional(CONF_ALARM_CONDITION_ACTIVE): TEXT_SENSOR_SCHEMA,
+        cv.Optional(CONF_ALARM_REASON): TEXT_SENSOR_SCHEMA,
+        cv.Optional(CONF_MODEL_DESCRIPTION): TEXT_SENSOR_SCHEMA,
     }
 )
 
@@ -86,3 +78,7 @@ def to_code(config):
             sens = cg.new_Pvariable(conf[CONF_ID])
             yield text_sensor.register_text_sensor(sens, conf)
             cg.add(getattr(hub, f"set_{key}_text_sensor")(sens))
+            if key in TEXT_TABLE_DEFINES:
+                cg.add_define(TEXT_TABLE_DEFINES[key])
+            if CONF_UPDATE_INTERVAL in conf:
+                cg.add(hub.set_update_interval(sens, conf[CONF_UPDATE_INTERVAL]))
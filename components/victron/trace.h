@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef USE_ESP32
+#include <atomic>
+#endif
+
+namespace esphome {
+namespace victron {
+
+#ifdef USE_VICTRON_TRACE
+#define VICTRON_TRACE(event, arg) this->trace_.record(event, arg, micros())
+#else
+#define VICTRON_TRACE(event, arg)
+#endif
+
+enum TraceEvent : uint8_t {
+  TRACE_FRAME_START,
+  TRACE_FRAME_OK,
+  TRACE_CHECKSUM_ERROR,
+  TRACE_RX_TIMEOUT,
+  TRACE_FRAME_REPEATED,
+  TRACE_THROTTLE_SKIP,
+  TRACE_PUBLISH_START,
+  TRACE_PUBLISH_END,
+};
+
+struct TraceEntry {
+  uint32_t time;
+  TraceEvent event;
+  uint16_t arg;
+};
+
+/// Fixed-size ring of timestamped parser events, the oldest entries are overwritten.
+///
+/// Recording is lock-free: with the RX task, the receiver and the main loop both record events.
+class TraceRing {
+ public:
+  static const uint32_t SIZE = 64;
+  // Latency buckets: < 1 ms, then [2^(i-1), 2^i) ms
+  static const uint8_t LATENCY_BUCKETS = 16;
+
+  void record(TraceEvent event, uint16_t arg, uint32_t time);
+  void record_latency(uint32_t latency_us);
+
+  /// Number of events recorded since boot, entry(i) is valid for the last min(count(), SIZE) of them.
+  uint32_t count() const { return this->head_; }
+  const TraceEntry &entry(uint32_t index) const { return this->entries_[index % SIZE]; }
+  uint32_t latency_bucket(uint8_t bucket) const { return this->latency_[bucket]; }
+
+ protected:
+  TraceEntry entries_[SIZE]{};
+#ifdef USE_ESP32
+  std::atomic<uint32_t> head_{0};
+#else
+  uint32_t head_{0};
+#endif
+  uint32_t latency_[LATENCY_BUCKETS]{};
+};
+
+inline void TraceRing::record(TraceEvent event, uint16_t arg, uint32_t time) {
+  TraceEntry &entry = this->entries_[this->head_++ % SIZE];
+  entry.time = time;
+  entry.event = event;
+  entry.arg = arg;
+}
+
+inline void TraceRing::record_latency(uint32_t latency_us) {
+  const uint32_t ms = latency_us / 1000;
+  uint8_t bucket = ms == 0 ? 0 : 32 - __builtin_clz(ms);
+  if (bucket >= LATENCY_BUCKETS)
+    bucket = LATENCY_BUCKETS - 1;
+  this->latency_[bucket]++;
+}
+
+}  // namespace victron
+}  // namespace esphome
@@ -1,14 +1,37 @@
 #include "victron.h"
 #include "esphome/core/log.h"
 #include <algorithm>  // std::min
+#include <cinttypes>
+#include <cmath>
+#include <cstring>
+#include <functional>
 
 namespace esphome {
 namespace victron {
 
 static const char *const TAG = "victron";
 
+static const size_t RX_CHUNK_SIZE = 64;
+// ms of silence after a complete frame which ends a burst of data
+static const uint32_t RX_IDLE_GAP = 20;
+
+#ifdef USE_ESP32
+static const uint32_t RX_TASK_STACK_SIZE = 3072;
+static const UBaseType_t RX_TASK_PRIORITY = 2;
+// ms, the RX buffer fills with ~2 bytes per ms at 19200 baud
+static const uint32_t RX_TASK_INTERVAL = 10;
+#endif
+
 void VictronComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Victron:");
+  ESP_LOGCONFIG(TAG, "  RX task: %s", YESNO(this->rx_task_));
+  ESP_LOGCONFIG(TAG, "  Fast alarms: %s", YESNO(this->fast_alarms_));
+  ESP_LOGCONFIG(TAG, "  Heartbeat: %" PRIu32 " ms", this->heartbeat_);
+  ESP_LOGCONFIG(TAG, "  Publish budget: %u", this->publish_budget_);
+  ESP_LOGCONFIG(TAG, "  Idle poll interval: %" PRIu32 " ms", this->idle_poll_interval_);
+  for (const auto &custom : this->custom_fields_)
+    ESP_LOGCONFIG(TAG, "  Custom field: %s", custom.label);
+  ESP_LOGCONFIG(TAG, "  Entities with own update interval: %u", (unsigned) this->scheduled_.size());
   LOG_BINARY_SENSOR("  ", "Load state", load_state_binary_sensor_);
   LOG_BINARY_SENSOR("  ", "Relay state", relay_state_binary_sensor_);
   LOG_SENSOR("  ", "Max Power Yesterday", max_power_yesterday_sensor_);
@@ -55,6 +78,10 @@ void VictronComponent::dump_config() {
   LOG_SENSOR("  ", "Last Full Charge", last_full_charge_sensor_);
   LOG_SENSOR("  ", "Amount Of Discharged Energy", amount_of_discharged_energy_sensor_);
   LOG_SENSOR("  ", "Amount Of Charged Energy", amount_of_charged_energy_sensor_);
+  LOG_SENSOR("  ", "Battery Power", battery_power_sensor_);
+  LOG_SENSOR("  ", "Charger Efficiency", charger_efficiency_sensor_);
+  LOG_SENSOR("  ", "Load Power", load_power_sensor_);
+  LOG_SENSOR("  ", "Midpoint Balance", midpoint_balance_sensor_);
   LOG_TEXT_SENSOR("  ", "Alarm Condition Active", alarm_condition_active_text_sensor_);
   LOG_TEXT_SENSOR("  ", "Alarm Reason", alarm_reason_text_sensor_);
   LOG_TEXT_SENSOR("  ", "Model Description", model_description_text_sensor_);
@@ -62,59 +89,590 @@ void VictronComponent::dump_config() {
   check_uart_settings(19200);
 }
 
+void VictronComponent::setup() {
+  // Sorted by entity, publish_state_() finds the scheduled entity by a binary search
+  std::sort(this->scheduled_.begin(), this->scheduled_.end(), [](const ScheduledEntity &a, const ScheduledEntity &b) {
+    return std::less<const void *>()(a.entity, b.entity);
+  });
+  const uint32_t now = millis();
+  for (uint16_t i = 0; i < this->scheduled_.size(); i++) {
+    this->scheduled_[i].next_due = now + this->scheduled_[i].interval;
+    this->schedule_.push_back(i);
+  }
+  std::make_heap(this->schedule_.begin(), this->schedule_.end(),
+                 [this](uint16_t a, uint16_t b) { return this->is_due_later_(a, b); });
+
+  // The custom labels are decoded into slots like the fields, the slot of a custom field has the same index
+  for (const auto &custom : this->custom_fields_) {
+    if (!add_custom_slot(this->custom_, custom.label, custom.type)) {
+      ESP_LOGE(TAG, "Only %u custom fields are supported", MAX_CUSTOM_SLOTS);
+      break;
+    }
+  }
+
+#ifdef USE_ESP32
+  if (this->rx_task_) {
+    this->frame_queue_ = new SpscRing<RawFrame, 4>();  // NOLINT(cppcoreguidelines-owning-memory)
+    if (xTaskCreate(VictronComponent::rx_task, "victron_rx", RX_TASK_STACK_SIZE, this, RX_TASK_PRIORITY,
+                    &this->rx_task_handle_) != pdPASS) {
+      ESP_LOGE(TAG, "Failed to create RX task");
+      this->mark_failed();
+    }
+  }
+#endif
+}
+
 void VictronComponent::loop() {
+#ifdef USE_ESP32
+  if (this->rx_task_) {
+    while (this->frame_queue_->pop(this->rx_frame_)) {
+      this->handle_frame_(this->rx_frame_);
+    }
+  } else {
+    this->receive_();
+  }
+#else
+  this->receive_();
+#endif
+
+  this->publish_pending_();
+  this->publish_scheduled_();
+
+  if (this->rx_timeouts_ != this->rx_timeouts_logged_) {
+    this->rx_timeouts_logged_ = this->rx_timeouts_;
+    ESP_LOGW(TAG, "Last transmission too long ago.");
+  }
+  if (this->frames_dropped_ != this->frames_dropped_logged_) {
+    ESP_LOGW(TAG, "%" PRIu32 " frame(s) dropped, main loop too slow",
+             this->frames_dropped_ - this->frames_dropped_logged_);
+    this->frames_dropped_logged_ = this->frames_dropped_;
+  }
+  const uint32_t checksum_errors = this->assembler_.checksum_errors();
+  if (checksum_errors != this->checksum_errors_logged_) {
+    ESP_LOGW(TAG, "%" PRIu32 " frame(s) with invalid checksum", checksum_errors - this->checksum_errors_logged_);
+    this->checksum_errors_logged_ = checksum_errors;
+  }
+}
+
+LinkStats VictronComponent::get_link_stats() const {
+  LinkStats stats;
+  stats.frames = this->frames_;
+  stats.frames_repeated = this->frames_repeated_;
+  stats.frames_dropped = this->frames_dropped_;
+  stats.checksum_errors = this->assembler_.checksum_errors();
+  stats.rx_timeouts = this->rx_timeouts_;
+  return stats;
+}
+
+#ifdef USE_VICTRON_TRACE
+static const char *const TRACE_EVENTS[] = {
+    "frame start", "frame ok", "checksum error", "rx timeout", "repeated", "throttled", "publish start", "publish end",
+};
+
+void VictronComponent::dump_trace() {
+  const uint32_t count = this->trace_.count();
+  const uint32_t first = count > TraceRing::SIZE ? count - TraceRing::SIZE : 0;
+  ESP_LOGI(TAG, "Trace: %" PRIu32 " event(s), showing the last %" PRIu32, count, count - first);
+  if (count > 0) {
+    // Relative to the oldest event shown
+    const uint32_t start = this->trace_.entry(first).time;
+    for (uint32_t i = first; i < count; i++) {
+      const TraceEntry &entry = this->trace_.entry(i);
+      ESP_LOGI(TAG, "  %10" PRIu32 " us  %-14s %u", entry.time - start, TRACE_EVENTS[entry.event], entry.arg);
+    }
+  }
+  ESP_LOGI(TAG, "First byte to publish latency:");
+  for (uint8_t bucket = 0; bucket < TraceRing::LATENCY_BUCKETS; bucket++) {
+    const uint32_t frames = this->trace_.latency_bucket(bucket);
+    if (frames == 0)
+      continue;
+    if (bucket == 0) {
+      ESP_LOGI(TAG, "  < 1 ms: %" PRIu32, frames);
+    } else {
+      ESP_LOGI(TAG, "  < %" PRIu32 " ms: %" PRIu32, (uint32_t) 1 << bucket, frames);
+    }
+  }
+}
+#else
+void VictronComponent::dump_trace() { ESP_LOGW(TAG, "Trace not compiled in, set 'trace: true'"); }
+#endif
+
+void VictronComponent::set_rx_enabled(bool rx_enabled) {
+  this->rx_enabled_ = rx_enabled;
+  if (!rx_enabled)
+    return;
+  this->rx_resync_ = true;
+  this->rx_active_ = true;
+  this->last_transmission_ = millis();
+}
+
+// ":8" (Set), address (little endian), flags, value and a checksum completing the sum of all bytes to 0x55.
+// The response of the device is an async HEX message, skipped by the assembler.
+void VictronComponent::set_register(uint16_t address, uint8_t value) {
+  const uint8_t bytes[] = {static_cast<uint8_t>(address), static_cast<uint8_t>(address >> 8), 0x00, value};
+  uint8_t checksum = 0x55 - 0x08;
+  char message[16] = ":8";
+  char *pos = message + 2;
+  for (const uint8_t byte : bytes) {
+    checksum -= byte;
+    pos += snprintf(pos, message + sizeof(message) - pos, "%02X", byte);
+  }
+  snprintf(pos, message + sizeof(message) - pos, "%02X\n", checksum);
+  ESP_LOGV(TAG, "Sending %s", message);
+  this->write_array(reinterpret_cast<const uint8_t *>(message), strlen(message));
+}
+
+#ifdef USE_ESP32
+void VictronComponent::rx_task(void *arg) {
+  auto *victron = static_cast<VictronComponent *>(arg);
+  while (true) {
+    victron->receive_();
+    // Sleep through the silence between two frames
+    const uint32_t interval =
+        victron->rx_active_ ? RX_TASK_INTERVAL : std::max(RX_TASK_INTERVAL, victron->idle_poll_interval_);
+    vTaskDelay(pdMS_TO_TICKS(interval));
+  }
+}
+#endif
+
+// Runs in the RX task if enabled. Must not log or publish.
+void VictronComponent::receive_() {
+  if (!this->rx_enabled_)
+    return;
+
   const uint32_t now = millis();
-  if ((state_ > 0) && (now - last_transmission_ >= 200)) {
+  // Between two frames the UART is only looked at once per poll interval
+  if (!this->rx_active_ && (now - this->last_poll_ < this->idle_poll_interval_))
+    return;
+  this->last_poll_ = now;
+
+  uint8_t chunk[RX_CHUNK_SIZE];
+  size_t len;
+  if (this->rx_resync_) {
+    // Skip the rest of a frame which was already being sent when the UART was switched over
+    while ((len = std::min<size_t>(available(), sizeof(chunk))) > 0) {
+      read_array(chunk, len);
+      this->last_transmission_ = now;
+    }
+    if (now - this->last_transmission_ < RX_IDLE_GAP)
+      return;
+    this->assembler_.reset();
+    this->assembler_.idle();
+    this->rx_resync_ = false;
+  }
+
+  if (this->assembler_.in_frame() && (now - this->last_transmission_ >= 200)) {
     // last transmission too long ago. Reset RX index.
-    ESP_LOGW(TAG, "Last transmission too long ago.");
-    state_ = 0;
+    this->assembler_.reset();
+    this->rx_timeouts_++;
+    VICTRON_TRACE(TRACE_RX_TIMEOUT, 0);
+  }
+
+  if (!available()) {
+    if (now - this->last_transmission_ >= RX_IDLE_GAP) {
+      // A pause is a frame boundary, the next frame can be verified without waiting for a "Checksum" line
+      this->assembler_.idle();
+      if (!this->assembler_.in_frame())
+        this->rx_active_ = false;
+    }
+    return;
+  }
+
+  this->rx_active_ = true;
+  this->last_transmission_ = now;
+  while (this->rx_enabled_ && (len = std::min<size_t>(available(), sizeof(chunk))) > 0) {
+    read_array(chunk, len);
+    const uint8_t *pos = chunk;
+    // A frame callback may disable receiving, the rest belongs to the next device
+    while (this->rx_enabled_ && len > 0) {
+#ifdef USE_VICTRON_TRACE
+      if (!this->assembler_.in_frame()) {
+        this->trace_frame_start_ = micros();
+        VICTRON_TRACE(TRACE_FRAME_START, 0);
+      }
+#endif
+      size_t consumed;
+      const bool complete = this->assembler_.feed(pos, len, &consumed);
+      pos += consumed;
+      len -= consumed;
+#ifdef USE_VICTRON_TRACE
+      if (this->assembler_.checksum_errors() != this->trace_checksum_errors_) {
+        this->trace_checksum_errors_ = this->assembler_.checksum_errors();
+        VICTRON_TRACE(TRACE_CHECKSUM_ERROR, 0);
+      }
+#endif
+      if (complete)
+        this->commit_frame_();
+    }
   }
+}
 
-  if (!available())
+void VictronComponent::commit_frame_() {
+  VICTRON_TRACE(TRACE_FRAME_OK, this->assembler_.frame().num_fields);
+#ifdef USE_ESP32
+  if (this->rx_task_) {
+    if (!this->frame_queue_->push(this->assembler_.frame()))
+      this->frames_dropped_++;
     return;
+  }
+#endif
+  this->handle_frame_(this->assembler_.frame());
+}
 
-  last_transmission_ = now;
-  while (available()) {
-    uint8_t c;
-    read_byte(&c);
-    if (state_ == 0) {
-      if ((c == '\r') || (c == '\n'))
-        continue;
-      label_.clear();
-      value_.clear();
-      state_ = 1;
+// Faults and alarms which bypass the throttle and the update intervals
+static const uint64_t PRIORITY_FIELDS = (uint64_t(1) << FIELD_ERROR_CODE) | (uint64_t(1) << FIELD_ALARM) |
+                                        (uint64_t(1) << FIELD_ALARM_REASON) | (uint64_t(1) << FIELD_WARNING_CODE) |
+                                        (uint64_t(1) << FIELD_RELAY);
+// Inputs of the derived sensors, indexed by DerivedSensor
+static const uint64_t DERIVED_INPUTS[] = {
+    (uint64_t(1) << FIELD_BATTERY_VOLTAGE) | (uint64_t(1) << FIELD_BATTERY_CURRENT),
+    (uint64_t(1) << FIELD_BATTERY_VOLTAGE) | (uint64_t(1) << FIELD_BATTERY_CURRENT) |
+        (uint64_t(1) << FIELD_PANEL_POWER),
+    (uint64_t(1) << FIELD_BATTERY_VOLTAGE) | (uint64_t(1) << FIELD_LOAD_CURRENT),
+    (uint64_t(1) << FIELD_BATTERY_VOLTAGE) | (uint64_t(1) << FIELD_MIDPOINT_VOLTAGE),
+};
+static const uint8_t ALL_DERIVED = (1 << sizeof(DERIVED_INPUTS) / sizeof(DERIVED_INPUTS[0])) - 1;
+
+// Derived sensors with an input in `fields`
+static uint8_t derived_of(uint64_t fields) {
+  uint8_t derived = 0;
+  for (uint8_t i = 0; i < sizeof(DERIVED_INPUTS) / sizeof(DERIVED_INPUTS[0]); i++) {
+    if (fields & DERIVED_INPUTS[i])
+      derived |= 1 << i;
+  }
+  return derived;
+}
+
+void VictronComponent::handle_frame_(const RawFrame &frame) {
+  const uint32_t now = millis();
+  // The first frame after locking on (boot, link reset) isn't delayed by the throttle
+  this->publishing_ = frame.first || now - this->last_publish_ >= this->throttle_;
+  if (this->publishing_)
+    this->last_publish_ = now;
+#ifdef USE_VICTRON_TRACE
+  // With the RX task the receiver may have started the next frame already, the latency is too low then
+  this->trace_latency_start_ = this->trace_frame_start_;
+  this->trace_latency_pending_ = this->publishing_;
+  if (!this->publishing_)
+    VICTRON_TRACE(TRACE_THROTTLE_SKIP, 0);
+#endif
+
+  this->frames_++;
+  if (this->is_repeated_(frame)) {
+    this->frames_repeated_++;
+    VICTRON_TRACE(TRACE_FRAME_REPEATED, 0);
+  } else {
+    begin_block(this->frame_, this->custom_);
+    for (uint8_t i = 0; i < frame.num_fields; i++) {
+      if (!decode_field(this->frame_, this->memo_, this->custom_, frame.fields[i]))
+        this->log_unhandled_(frame.fields[i]);
     }
-    if (state_ == 1) {
-      if (c == '\t')
-        state_ = 2;
-      else
-        label_.push_back(c);
+    this->fingerprints_[this->next_fingerprint_].received = this->frame_.received;
+    this->fingerprints_[this->next_fingerprint_].custom_received = this->custom_.received;
+    this->dirty_ |= this->frame_.changed;
+    this->custom_dirty_ |= this->custom_.changed;
+    this->derived_dirty_ |= derived_of(this->frame_.changed);
+  }
+  this->frame_callback_.call(this->frame_);
+
+  if (this->publishing_ && now - this->last_heartbeat_ >= this->heartbeat_) {
+    // Publish everything, also the values which didn't change
+    this->last_heartbeat_ = now;
+    this->dirty_ |= this->frame_.valid | this->frame_.received;
+    this->custom_dirty_ |= this->custom_.valid | this->custom_.received;
+    this->derived_dirty_ = ALL_DERIVED;
+  }
+
+  // Only changed fields are published, by loop() within the publish budget
+  const uint64_t alarms = this->fast_alarms_ ? this->frame_.changed & PRIORITY_FIELDS : 0;
+  this->pending_ |= alarms;
+  this->pending_alarms_ |= alarms;
+  this->dirty_ &= ~alarms;
+  if (this->publishing_) {
+    this->pending_ |= this->dirty_;
+    this->dirty_ = 0;
+    this->derived_pending_ |= this->derived_dirty_;
+    this->derived_dirty_ = 0;
+    this->custom_pending_ |= this->custom_dirty_;
+    this->custom_dirty_ = 0;
+  } else if (!this->scheduled_.empty()) {
+    // Throttled frames still update the values of the scheduled entities, nothing is published here
+    uint64_t update = this->frame_.changed & ~this->pending_;
+    while (update != 0) {
+      const auto field = static_cast<FrameField>(__builtin_ctzll(update));
+      update &= update - 1;
+      this->publish_field_(field);
+    }
+    uint8_t derived = derived_of(this->frame_.changed) & ~this->derived_pending_;
+    while (derived != 0) {
+      const auto sensor = static_cast<DerivedSensor>(__builtin_ctz(derived));
+      derived &= derived - 1;
+      this->publish_derived_(sensor);
+    }
+    update = this->custom_.changed & ~this->custom_pending_;
+    while (update != 0) {
+      const uint8_t slot = __builtin_ctzll(update);
+      update &= update - 1;
+      this->publish_custom_(slot);
+    }
+  }
+}
+
+void VictronComponent::publish_pending_() {
+  if (!this->has_pending_())
+    return;
+
+  const bool publishing = this->publishing_;
+  this->publishing_ = true;
+  this->publishes_ = 0;
+  VICTRON_TRACE(TRACE_PUBLISH_START, __builtin_popcountll(this->pending_) + __builtin_popcount(this->derived_pending_) +
+                                         __builtin_popcountll(this->custom_pending_));
+  // Alarms first, then in the order of the fields: the live values come before the counters. Derived sensors and
+  // custom fields last.
+  while (this->has_pending_() && (this->publish_budget_ == 0 || this->publishes_ < this->publish_budget_)) {
+    if (this->pending_ == 0 && this->derived_pending_ != 0) {
+      const auto derived = static_cast<DerivedSensor>(__builtin_ctz(this->derived_pending_));
+      this->derived_pending_ &= ~(1 << derived);
+      this->publish_derived_(derived);
       continue;
     }
-    if (state_ == 2) {
-      if (label_ == "Checksum") {
-        state_ = 0;
-        // The checksum is used as end of frame indicator
-        if (now - this->last_publish_ >= this->throttle_) {
-          this->last_publish_ = now;
-          this->publishing_ = true;
-        } else {
-          this->publishing_ = false;
-        }
-        continue;
-      }
-      if ((c == '\r') || (c == '\n')) {
-        if (this->publishing_) {
-          handle_value_();
-        }
-        state_ = 0;
+    if (this->pending_ == 0) {
+      const uint8_t slot = __builtin_ctzll(this->custom_pending_);
+      this->custom_pending_ &= ~slot_bit(slot);
+      this->publish_custom_(slot);
+      continue;
+    }
+    const uint64_t candidates = this->pending_alarms_ != 0 ? this->pending_alarms_ : this->pending_;
+    const auto field = static_cast<FrameField>(__builtin_ctzll(candidates));
+    const uint64_t bit = field_bit(field);
+    this->pending_ &= ~bit;
+    this->priority_ = this->pending_alarms_ & bit;
+    this->pending_alarms_ &= ~bit;
+    this->publish_field_(field);
+  }
+  this->priority_ = false;
+  this->publishing_ = publishing;
+  VICTRON_TRACE(TRACE_PUBLISH_END, this->publishes_);
+#ifdef USE_VICTRON_TRACE
+  if (!this->has_pending_() && this->trace_latency_pending_) {
+    this->trace_.record_latency(micros() - this->trace_latency_start_);
+    this->trace_latency_pending_ = false;
+  }
+#endif
+}
+
+// A block byte-identical to the last one of its kind isn't decoded at all
+bool VictronComponent::is_repeated_(const RawFrame &frame) {
+  if (frame.num_fields == 0)
+    return false;
+
+  const char *label = frame.fields[0].label;
+  uint8_t index = 0;
+  while (index < 2 && strcmp(this->fingerprints_[index].label, label) != 0)
+    index++;
+
+  if (index == 2) {
+    // Replace the other kind of block
+    index = this->next_fingerprint_ ^ 1;
+    BlockFingerprint &slot = this->fingerprints_[index];
+    strcpy(slot.label, label);  // NOLINT(clang-analyzer-security.insecureAPI.strcpy)
+    slot.fingerprint = frame.fingerprint;
+    this->next_fingerprint_ = index;
+    return false;
+  }
+
+  this->next_fingerprint_ = index;
+  BlockFingerprint &slot = this->fingerprints_[index];
+  if (slot.fingerprint != frame.fingerprint) {
+    slot.fingerprint = frame.fingerprint;
+    return false;
+  }
+
+  this->frame_.changed = 0;
+  this->frame_.received = slot.received;
+  this->custom_.changed = 0;
+  this->custom_.received = slot.custom_received;
+  return true;
+}
+
+static const uint8_t MAX_UNHANDLED_LABELS = 16;
+
+void VictronComponent::log_unhandled_(const RawField &field) {
+  // Bounded, corrupted labels would grow the list otherwise
+  if (this->unhandled_labels_.size() >= MAX_UNHANDLED_LABELS)
+    return;
+  for (const auto &label : this->unhandled_labels_) {
+    if (label == field.label)
+      return;
+  }
+  this->unhandled_labels_.emplace_back(field.label);
+  ESP_LOGD(TAG, "Unhandled property: %s %s", field.label, field.value);
+}
+
+void VictronComponent::add_custom_field(const std::string &label, FieldType type, float scale, float offset,
+                                        sensor::Sensor *sensor) {
+  CustomField field;
+  strncpy(field.label, label.c_str(), MAX_LABEL_LENGTH);
+  field.label[MAX_LABEL_LENGTH] = '\0';
+  field.type = type;
+  field.scale = scale;
+  field.offset = offset;
+  field.sensor = sensor;
+  this->custom_fields_.push_back(field);
+}
+
+void VictronComponent::add_custom_field(const std::string &label, binary_sensor::BinarySensor *binary_sensor) {
+  CustomField field;
+  strncpy(field.label, label.c_str(), MAX_LABEL_LENGTH);
+  field.label[MAX_LABEL_LENGTH] = '\0';
+  field.type = TYPE_ON_OFF;
+  field.binary_sensor = binary_sensor;
+  this->custom_fields_.push_back(field);
+}
+
+void VictronComponent::add_custom_field(const std::string &label, text_sensor::TextSensor *text_sensor) {
+  CustomField field;
+  strncpy(field.label, label.c_str(), MAX_LABEL_LENGTH);
+  field.label[MAX_LABEL_LENGTH] = '\0';
+  field.type = TYPE_TEXT;
+  field.text_sensor = text_sensor;
+  this->custom_fields_.push_back(field);
+}
+
+void VictronComponent::publish_custom_(uint8_t slot) {
+  const CustomField &custom = this->custom_fields_[slot];
+  const CustomSlot &decoded = this->custom_.slots[slot];
+  const bool valid = this->custom_.valid & slot_bit(slot);
+  if (custom.text_sensor != nullptr) {
+    this->publish_state_(custom.text_sensor, decoded.text);
+  } else if (custom.binary_sensor != nullptr) {
+    if (valid)
+      this->publish_state_(custom.binary_sensor, decoded.value != 0);
+  } else {
+    this->publish_state_(custom.sensor, valid ? decoded.value * custom.scale + custom.offset : NAN);
+  }
+}
+
+void VictronComponent::set_update_interval(sensor::Sensor *sensor, uint32_t update_interval) {
+  ScheduledEntity entity;
+  entity.entity = sensor;
+  entity.sensor = sensor;
+  entity.interval = update_interval;
+  this->scheduled_.push_back(entity);
+}
+
+void VictronComponent::set_update_interval(text_sensor::TextSensor *text_sensor, uint32_t update_interval) {
+  ScheduledEntity entity;
+  entity.entity = text_sensor;
+  entity.text_sensor = text_sensor;
+  entity.interval = update_interval;
+  this->scheduled_.push_back(entity);
+}
+
+void VictronComponent::set_update_interval(binary_sensor::BinarySensor *binary_sensor, uint32_t update_interval) {
+  ScheduledEntity entity;
+  entity.entity = binary_sensor;
+  entity.binary_sensor = binary_sensor;
+  entity.interval = update_interval;
+  this->scheduled_.push_back(entity);
+}
+
+VictronComponent::ScheduledEntity *VictronComponent::find_scheduled_(const void *entity) {
+  if (this->scheduled_.empty())
+    return nullptr;
+  auto it = std::lower_bound(this->scheduled_.begin(), this->scheduled_.end(), entity,
+                             [](const ScheduledEntity &scheduled, const void *entity) {
+                               return std::less<const void *>()(scheduled.entity, entity);
+                             });
+  return it != this->scheduled_.end() && it->entity == entity ? &*it : nullptr;
+}
+
+// The latest value of a scheduled entity was stored. Returns true if it is to be published right away: the first
+// valid value, so the entity isn't unknown for a whole interval after boot, and priority fields.
+bool VictronComponent::update_scheduled_(ScheduledEntity *scheduled, bool valid) {
+  if (!valid || scheduled->has_value)
+    return this->priority_;
+  scheduled->has_value = true;
+  scheduled->next_due = millis() + scheduled->interval;
+  this->schedule_changed_ = true;
+  return true;
+}
+
+bool VictronComponent::is_due_later_(uint16_t a, uint16_t b) const {
+  return (int32_t) (this->scheduled_[a].next_due - this->scheduled_[b].next_due) > 0;
+}
+
+void VictronComponent::publish_scheduled_() {
+  if (this->schedule_.empty())
+    return;
+
+  // Min-heap ordered by the due time, the earliest entity is at the front
+  auto later = [this](uint16_t a, uint16_t b) { return this->is_due_later_(a, b); };
+  if (this->schedule_changed_) {
+    std::make_heap(this->schedule_.begin(), this->schedule_.end(), later);
+    this->schedule_changed_ = false;
+  }
+  const uint32_t now = millis();
+  while ((int32_t) (now - this->scheduled_[this->schedule_.front()].next_due) >= 0) {
+    std::pop_heap(this->schedule_.begin(), this->schedule_.end(), later);
+    ScheduledEntity &entity = this->scheduled_[this->schedule_.back()];
+
+    if (entity.has_value) {
+      if (entity.sensor != nullptr) {
+        entity.sensor->publish_state(entity.value);
+      } else if (entity.text_sensor != nullptr) {
+        entity.text_sensor->publish_state(entity.text);
       } else {
-        value_.push_back(c);
+        entity.binary_sensor->publish_state(entity.state);
       }
     }
+
+    entity.next_due += entity.interval;
+    // Don't try to catch up after the main loop was blocked
+    if ((int32_t) (now - entity.next_due) >= 0)
+      entity.next_due = now + entity.interval;
+    std::push_heap(this->schedule_.begin(), this->schedule_.end(), later);
+  }
+}
+
+void VictronComponent::publish_derived_(DerivedSensor derived) {
+  const uint64_t inputs = DERIVED_INPUTS[derived];
+  if ((this->frame_.valid & inputs) != inputs)
+    return;
+
+  const int32_t *in = this->frame_.values;
+  // mV * mA = uW
+  const int64_t battery_power = (int64_t) in[FIELD_BATTERY_VOLTAGE] * in[FIELD_BATTERY_CURRENT];
+
+  switch (derived) {
+    case DERIVED_BATTERY_POWER:
+      this->publish_state_(this->battery_power_sensor_, battery_power / 1000000.0f);
+      break;
+    case DERIVED_CHARGER_EFFICIENCY: {
+      // uW / (W * 10000) = %
+      const int32_t panel_power = in[FIELD_PANEL_POWER];
+      this->publish_state_(this->charger_efficiency_sensor_,
+                           panel_power > 0 ? battery_power / (panel_power * 10000.0f) : NAN);
+      break;
+    }
+    case DERIVED_LOAD_POWER: {
+      // mV * mA = uW
+      const int64_t load_power = (int64_t) in[FIELD_BATTERY_VOLTAGE] * in[FIELD_LOAD_CURRENT];
+      this->publish_state_(this->load_power_sensor_, load_power / 1000000.0f);
+      break;
+    }
+    case DERIVED_MIDPOINT_BALANCE:
+      // Upper half minus lower half of the battery bank, mV to V
+      this->publish_state_(this->midpoint_balance_sensor_,
+                           (in[FIELD_BATTERY_VOLTAGE] - 2 * in[FIELD_MIDPOINT_VOLTAGE]) / 1000.0f);
+      break;
+    default:
+      break;
   }
 }
 
+// The text tables are only compiled in if a text sensor using them is configured
+#ifdef USE_VICTRON_CHARGING_MODE_TEXT
 static const std::string charging_mode_text(int value) {
   switch (value) {
     case 0:
@@ -151,7 +709,9 @@ static const std::string charging_mode_text(int value) {
       return "Unknown";
   }
 }
+#endif
 
+#ifdef USE_VICTRON_ERROR_TEXT
 static const std::string error_code_text(int value) {
   switch (value) {
     case 0:
@@ -198,7 +758,9 @@ static const std::string error_code_text(int value) {
       return "Unknown";
   }
 }
+#endif
 
+#ifdef USE_VICTRON_WARNING_TEXT
 static const std::string warning_code_text(int value) {
   switch (value) {
     case 0:
@@ -231,7 +793,9 @@ static const std::string warning_code_text(int value) {
       return "Multiple warnings";
   }
 }
+#endif
 
+#ifdef USE_VICTRON_TRACKING_MODE_TEXT
 static const std::string tracking_mode_text(int value) {
   switch (value) {
     case 0:
@@ -244,7 +808,9 @@ static const std::string tracking_mode_text(int value) {
       return "Unknown";
   }
 }
+#endif
 
+#ifdef USE_VICTRON_DEVICE_MODE_TEXT
 static const std::string device_mode_text(int value) {
   switch (value) {
     case 0:
@@ -259,7 +825,9 @@ static const std::string device_mode_text(int value) {
       return "Unknown";
   }
 }
+#endif
 
+#ifdef USE_VICTRON_DEVICE_TYPE_TEXT
 static const std::string device_type_text(int value) {
   switch (value) {
     case 0x203:
@@ -534,395 +1102,271 @@ static const std::string device_type_text(int value) {
       return "Unknown";
   }
 }
-
-void VictronComponent::handle_value_() {
-  int value;
-
-  if (label_ == "V") {
-    this->publish_state_(battery_voltage_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "V2") {
-    // mV to V
-    this->publish_state_(battery_voltage_2_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "V3") {
-    // mV to V
-    this->publish_state_(battery_voltage_3_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "VS") {
-    // mV to V
-    this->publish_state_(auxiliary_battery_voltage_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "VM") {
-    // mV to V
-    this->publish_state_(midpoint_voltage_of_the_battery_bank_sensor_,
-                         atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "DM") {
-    // Per mill to %
-    this->publish_state_(midpoint_deviation_of_the_battery_bank_sensor_,
-                         atoi(value_.c_str()) * 0.10f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "VPV") {
-    // mV to V
-    this->publish_state_(panel_voltage_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "PPV") {
-    this->publish_state_(panel_power_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "I") {
-    // mA to A
-    this->publish_state_(battery_current_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "I2") {
-    // mA to A
-    this->publish_state_(battery_current_2_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "I3") {
-    // mA to A
-    this->publish_state_(battery_current_3_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "IL") {
-    this->publish_state_(load_current_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "LOAD") {
-    this->publish_state_(load_state_binary_sensor_, value_ == "ON");
-    return;
-  }
-
-  if (label_ == "T") {
-    if (value_ == "---") {
-      this->publish_state_(battery_temperature_sensor_, NAN);
-      return;
+#endif
+
+void VictronComponent::publish_field_(FrameField field) {
+  // Fields reported as "---" are published as NAN
+  const float value = this->frame_.has(field) ? this->frame_.get(field) : NAN;
+  const int32_t code = this->frame_.get(field);
+
+  switch (field) {
+    case FIELD_BATTERY_VOLTAGE:
+      // mV to V
+      this->publish_state_(battery_voltage_sensor_, value / 1000.0f);
+      break;
+    case FIELD_BATTERY_VOLTAGE_2:
+      this->publish_state_(battery_voltage_2_sensor_, value / 1000.0f);
+      break;
+    case FIELD_BATTERY_VOLTAGE_3:
+      this->publish_state_(battery_voltage_3_sensor_, value / 1000.0f);
+      break;
+    case FIELD_AUXILIARY_VOLTAGE:
+      this->publish_state_(auxiliary_battery_voltage_sensor_, value / 1000.0f);
+      break;
+    case FIELD_MIDPOINT_VOLTAGE:
+      this->publish_state_(midpoint_voltage_of_the_battery_bank_sensor_, value / 1000.0f);
+      break;
+    case FIELD_MIDPOINT_DEVIATION:
+      // Per mill to %
+      this->publish_state_(midpoint_deviation_of_the_battery_bank_sensor_, value * 0.10f);
+      break;
+    case FIELD_PANEL_VOLTAGE:
+      this->publish_state_(panel_voltage_sensor_, value / 1000.0f);
+      break;
+    case FIELD_PANEL_POWER:
+      this->publish_state_(panel_power_sensor_, value);
+      break;
+    case FIELD_BATTERY_CURRENT:
+      // mA to A
+      this->publish_state_(battery_current_sensor_, value / 1000.0f);
+      break;
+    case FIELD_BATTERY_CURRENT_2:
+      this->publish_state_(battery_current_2_sensor_, value / 1000.0f);
+      break;
+    case FIELD_BATTERY_CURRENT_3:
+      this->publish_state_(battery_current_3_sensor_, value / 1000.0f);
+      break;
+    case FIELD_LOAD_CURRENT:
+      this->publish_state_(load_current_sensor_, value / 1000.0f);
+      break;
+    case FIELD_LOAD_STATE:
+      this->publish_state_(load_state_binary_sensor_, code != 0);
+      break;
+    case FIELD_BATTERY_TEMPERATURE:
+      this->publish_state_(battery_temperature_sensor_, value);
+      break;
+    case FIELD_INSTANTANEOUS_POWER:
+      this->publish_state_(instantaneous_power_sensor_, value);
+      break;
+    case FIELD_CONSUMED_AMP_HOURS:
+      // mAh -> Ah
+      this->publish_state_(consumed_amp_hours_sensor_, value / 1000.0f);
+      break;
+    case FIELD_STATE_OF_CHARGE:
+      // Per mill to %
+      this->publish_state_(state_of_charge_sensor_, value * 0.10f);
+      break;
+    case FIELD_TIME_TO_GO:
+      this->publish_state_(time_to_go_sensor_, value);
+      break;
+    case FIELD_ALARM:
+      this->publish_state_(alarm_condition_active_text_sensor_, code != 0 ? "ON" : "OFF");
+      break;
+    case FIELD_RELAY:
+      this->publish_state_(relay_state_binary_sensor_, code != 0);
+      break;
+    case FIELD_ALARM_REASON:
+#ifdef USE_VICTRON_ERROR_TEXT
+      this->publish_state_(alarm_reason_text_sensor_, error_code_text(code));
+#endif
+      break;
+    case FIELD_DEEPEST_DISCHARGE:
+      // mAh -> Ah
+      this->publish_state_(depth_of_the_deepest_discharge_sensor_, value / 1000.0f);
+      break;
+    case FIELD_LAST_DISCHARGE:
+      this->publish_state_(depth_of_the_last_discharge_sensor_, value / 1000.0f);
+      break;
+    case FIELD_AVERAGE_DISCHARGE:
+      this->publish_state_(depth_of_the_average_discharge_sensor_, value / 1000.0f);
+      break;
+    case FIELD_CHARGE_CYCLES:
+      this->publish_state_(number_of_charge_cycles_sensor_, value);
+      break;
+    case FIELD_FULL_DISCHARGES:
+      this->publish_state_(number_of_full_discharges_sensor_, value);
+      break;
+    case FIELD_CUMULATIVE_AMP_HOURS:
+      this->publish_state_(cumulative_amp_hours_drawn_sensor_, value / 1000.0f);
+      break;
+    case FIELD_MIN_BATTERY_VOLTAGE:
+      // mV to V
+      this->publish_state_(min_battery_voltage_sensor_, value / 1000.0f);
+      break;
+    case FIELD_MAX_BATTERY_VOLTAGE:
+      this->publish_state_(max_battery_voltage_sensor_, value / 1000.0f);
+      break;
+    case FIELD_LAST_FULL_CHARGE:
+      // sec -> min
+      this->publish_state_(last_full_charge_sensor_, value / 60.0f);
+      break;
+    case FIELD_AUTOMATIC_SYNCHRONIZATIONS:
+      this->publish_state_(number_of_automatic_synchronizations_sensor_, value);
+      break;
+    case FIELD_LOW_MAIN_VOLTAGE_ALARMS:
+      this->publish_state_(number_of_low_main_voltage_alarms_sensor_, value);
+      break;
+    case FIELD_HIGH_MAIN_VOLTAGE_ALARMS:
+      this->publish_state_(number_of_high_main_voltage_alarms_sensor_, value);
+      break;
+    case FIELD_LOW_AUXILIARY_VOLTAGE_ALARMS:
+      this->publish_state_(number_of_low_auxiliary_voltage_alarms_sensor_, value);
+      break;
+    case FIELD_HIGH_AUXILIARY_VOLTAGE_ALARMS:
+      this->publish_state_(number_of_high_auxiliary_voltage_alarms_sensor_, value);
+      break;
+    case FIELD_MIN_AUXILIARY_VOLTAGE:
+      // mV to V
+      this->publish_state_(min_auxiliary_battery_voltage_sensor_, value / 1000.0f);
+      break;
+    case FIELD_MAX_AUXILIARY_VOLTAGE:
+      this->publish_state_(max_auxiliary_battery_voltage_sensor_, value / 1000.0f);
+      break;
+    case FIELD_DISCHARGED_ENERGY:
+      // 0.01 kWh to Wh
+      this->publish_state_(amount_of_discharged_energy_sensor_, value * 10.0f);
+      break;
+    case FIELD_CHARGED_ENERGY:
+      this->publish_state_(amount_of_charged_energy_sensor_, value * 10.0f);
+      break;
+    case FIELD_YIELD_TOTAL:
+      this->publish_state_(yield_total_sensor_, value * 10.0f);
+      break;
+    case FIELD_YIELD_TODAY:
+      this->publish_state_(yield_today_sensor_, value * 10.0f);
+      break;
+    case FIELD_MAX_POWER_TODAY:
+      this->publish_state_(max_power_today_sensor_, value);
+      break;
+    case FIELD_YIELD_YESTERDAY:
+      this->publish_state_(yield_yesterday_sensor_, value * 10.0f);
+      break;
+    case FIELD_MAX_POWER_YESTERDAY:
+      this->publish_state_(max_power_yesterday_sensor_, value);
+      break;
+    case FIELD_ERROR_CODE:
+      this->publish_state_(error_code_sensor_, value);
+#ifdef USE_VICTRON_ERROR_TEXT
+      this->publish_state_(error_text_sensor_, error_code_text(code));
+#endif
+      break;
+    case FIELD_CHARGING_MODE:
+      this->publish_state_(charging_mode_id_sensor_, value);
+#ifdef USE_VICTRON_CHARGING_MODE_TEXT
+      this->publish_state_(charging_mode_text_sensor_, charging_mode_text(code));
+#endif
+      break;
+    case FIELD_MODEL_DESCRIPTION:
+      this->publish_state_(model_description_text_sensor_, this->frame_.model_description);
+      break;
+    case FIELD_FIRMWARE: {
+      // "159" to "1.59"
+      std::string firmware = this->frame_.firmware;
+      if (firmware.size() >= 2)
+        firmware.insert(firmware.size() - 2, ".");
+      this->publish_state_(firmware_version_text_sensor_, firmware);
+      break;
     }
-
-    this->publish_state_(battery_temperature_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "P") {
-    this->publish_state_(instantaneous_power_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "CE") {
-    // mAh -> Ah
-    this->publish_state_(consumed_amp_hours_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "SOC") {
-    // Per mill to %
-    this->publish_state_(state_of_charge_sensor_, atoi(value_.c_str()) * 0.10f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "TTG") {
-    this->publish_state_(time_to_go_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "Alarm") {
-    this->publish_state_(alarm_condition_active_text_sensor_, value_);
-    return;
-  }
-
-  if (label_ == "RELAY") {
-    this->publish_state_(relay_state_binary_sensor_, value_ == "ON");
-    return;
-  }
-
-  if (label_ == "AR") {
-    this->publish_state_(alarm_reason_text_sensor_, error_code_text(atoi(value_.c_str())));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  // @TODO: "OR"                Off reason
-
-  if (label_ == "H1") {
-    // mAh -> Ah
-    this->publish_state_(depth_of_the_deepest_discharge_sensor_,
-                         atoi(value_.c_str()) / 1000.0);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H2") {
-    // mAh -> Ah
-    this->publish_state_(depth_of_the_last_discharge_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H3") {
-    // mAh -> Ah
-    this->publish_state_(depth_of_the_average_discharge_sensor_,
-                         atoi(value_.c_str()) / 1000.0);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H4") {
-    this->publish_state_(number_of_charge_cycles_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H5") {
-    this->publish_state_(number_of_full_discharges_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H6") {
-    if (value_ == "---") {
-      this->publish_state_(cumulative_amp_hours_drawn_sensor_, NAN);
-      return;
-    }
-
-    // mAh -> Ah
-    this->publish_state_(cumulative_amp_hours_drawn_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H7") {
-    // mV to V
-    this->publish_state_(min_battery_voltage_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H8") {
-    // mV to V
-    this->publish_state_(max_battery_voltage_sensor_, atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H9") {
-    if (value_ == "---") {
-      this->publish_state_(last_full_charge_sensor_, NAN);
-      return;
-    }
-
-    // sec -> min
-    this->publish_state_(last_full_charge_sensor_, (float) atoi(value_.c_str()) / 60.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H10") {
-    if (value_ == "---") {
-      this->publish_state_(number_of_automatic_synchronizations_sensor_, NAN);
-      return;
-    }
-
-    this->publish_state_(number_of_automatic_synchronizations_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H11") {
-    this->publish_state_(number_of_low_main_voltage_alarms_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H12") {
-    this->publish_state_(number_of_high_main_voltage_alarms_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H13") {
-    this->publish_state_(number_of_low_auxiliary_voltage_alarms_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H14") {
-    this->publish_state_(number_of_high_auxiliary_voltage_alarms_sensor_,
-                         atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H15") {
-    // mV to V
-    this->publish_state_(min_auxiliary_battery_voltage_sensor_,
-                         atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H16") {
-    // mV to V
-    this->publish_state_(max_auxiliary_battery_voltage_sensor_,
-                         atoi(value_.c_str()) / 1000.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  // "H17"    0.01 kWh   Amount of discharged energy (BMV) / Amount of produced energy (DC monitor)
-  if (label_ == "H17") {
-    // Wh
-    this->publish_state_(amount_of_discharged_energy_sensor_, atoi(value_.c_str()) * 10.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  // "H18"    0.01 kWh   Amount of charged energy (BMV) / Amount of consumed energy (DC monitor)
-  if (label_ == "H18") {
-    // Wh
-    this->publish_state_(amount_of_charged_energy_sensor_, atoi(value_.c_str()) * 10.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H19") {
-    this->publish_state_(yield_total_sensor_, atoi(value_.c_str()) * 10.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H20") {
-    this->publish_state_(yield_today_sensor_, atoi(value_.c_str()) * 10.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H21") {
-    this->publish_state_(max_power_today_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H22") {
-    this->publish_state_(yield_yesterday_sensor_, atoi(value_.c_str()) * 10.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "H23") {
-    this->publish_state_(max_power_yesterday_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "ERR") {
-    value = atoi(value_.c_str());  // NOLINT(cert-err34-c)
-    this->publish_state_(error_code_sensor_, value);
-    this->publish_state_(error_text_sensor_, error_code_text(value));
-    return;
-  }
-
-  if (label_ == "CS") {
-    value = atoi(value_.c_str());  // NOLINT(cert-err34-c)
-    this->publish_state_(charging_mode_id_sensor_, (float) value);
-    this->publish_state_(charging_mode_text_sensor_, charging_mode_text(value));
-    return;
-  }
-
-  // "BMV"               Model description (deprecated)
-  if (label_ == "BMV") {
-    this->publish_state_(model_description_text_sensor_, value_);
-    return;
-  }
-
-  if (label_ == "FW") {
-    this->publish_state_once_(firmware_version_text_sensor_, value_.insert(value_.size() - 2, "."));
-    return;
-  }
-
-  // @TODO: "FWE"               Firmware version (24 bit)
-
-  if (label_ == "PID") {
-    this->publish_state_once_(device_type_text_sensor_, device_type_text(strtol(value_.c_str(), nullptr, 0)));
-    return;
-  }
-
-  if (label_ == "SER#") {
-    this->publish_state_once_(serial_number_text_sensor_, value_);
-    return;
-  }
-
-  if (label_ == "HSDS") {
-    this->publish_state_(day_number_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "MODE") {
-    value = atoi(value_.c_str());  // NOLINT(cert-err34-c)
-    this->publish_state_(device_mode_id_sensor_, (float) value);
-    this->publish_state_(device_mode_text_sensor_, device_mode_text(value));
-    return;
-  }
-
-  if (label_ == "AC_OUT_V") {
-    this->publish_state_(ac_out_voltage_sensor_, atoi(value_.c_str()) / 100.0f);  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "AC_OUT_I") {
-    this->publish_state_(ac_out_current_sensor_, std::max(0.0f, atoi(value_.c_str()) / 10.0f));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "AC_OUT_S") {
-    this->publish_state_(ac_out_apparent_power_sensor_, atoi(value_.c_str()));  // NOLINT(cert-err34-c)
-    return;
-  }
-
-  if (label_ == "WARN") {
-    value = atoi(value_.c_str());  // NOLINT(cert-err34-c)
-    this->publish_state_(warning_code_sensor_, value);
-    this->publish_state_(warning_text_sensor_, warning_code_text(value));
-    return;
-  }
-
-  if (label_ == "MPPT") {
-    value = atoi(value_.c_str());  // NOLINT(cert-err34-c)
-    this->publish_state_(tracking_mode_id_sensor_, (float) value);
-    this->publish_state_(tracking_mode_text_sensor_, tracking_mode_text(value));
-    return;
+    case FIELD_PRODUCT_ID:
+#ifdef USE_VICTRON_DEVICE_TYPE_TEXT
+      this->publish_state_(device_type_text_sensor_, device_type_text(code));
+#endif
+      break;
+    case FIELD_SERIAL_NUMBER:
+      this->publish_state_(serial_number_text_sensor_, this->frame_.serial_number);
+      break;
+    case FIELD_DAY_NUMBER:
+      this->publish_state_(day_number_sensor_, value);
+      break;
+    case FIELD_DEVICE_MODE:
+      this->publish_state_(device_mode_id_sensor_, value);
+#ifdef USE_VICTRON_DEVICE_MODE_TEXT
+      this->publish_state_(device_mode_text_sensor_, device_mode_text(code));
+#endif
+      break;
+    case FIELD_AC_OUT_VOLTAGE:
+      this->publish_state_(ac_out_voltage_sensor_, value / 100.0f);
+      break;
+    case FIELD_AC_OUT_CURRENT:
+      this->publish_state_(ac_out_current_sensor_, std::max(0.0f, value / 10.0f));
+      break;
+    case FIELD_AC_OUT_APPARENT_POWER:
+      this->publish_state_(ac_out_apparent_power_sensor_, value);
+      break;
+    case FIELD_WARNING_CODE:
+      this->publish_state_(warning_code_sensor_, value);
+#ifdef USE_VICTRON_WARNING_TEXT
+      this->publish_state_(warning_text_sensor_, warning_code_text(code));
+#endif
+      break;
+    case FIELD_TRACKING_MODE:
+      this->publish_state_(tracking_mode_id_sensor_, value);
+#ifdef USE_VICTRON_TRACKING_MODE_TEXT
+      this->publish_state_(tracking_mode_text_sensor_, tracking_mode_text(code));
+#endif
+      break;
+    default:
+      // @TODO: "OR" Off reason, "FWE" Firmware version (24 bit), "MON" DC monitor mode
+      break;
   }
-
-  // @TODO: "MON"               DC monitor mode
-
-  ESP_LOGD(TAG, "Unhandled property: %s %s", label_.c_str(), value_.c_str());
 }
 
 void VictronComponent::publish_state_(binary_sensor::BinarySensor *binary_sensor, const bool &state) {
   if (binary_sensor == nullptr)
     return;
 
+  ScheduledEntity *scheduled = this->find_scheduled_(binary_sensor);
+  if (scheduled != nullptr) {
+    scheduled->state = state;
+    if (!this->update_scheduled_(scheduled, true))
+      return;
+  } else if (!this->publishing_ && !this->priority_)
+    return;
+
   binary_sensor->publish_state(state);
+  this->publishes_++;
 }
 
 void VictronComponent::publish_state_(sensor::Sensor *sensor, float value) {
   if (sensor == nullptr)
     return;
 
-  sensor->publish_state(value);
-}
-
-void VictronComponent::publish_state_(text_sensor::TextSensor *text_sensor, const std::string &state) {
-  if (text_sensor == nullptr)
+  ScheduledEntity *scheduled = this->find_scheduled_(sensor);
+  if (scheduled != nullptr) {
+    scheduled->value = value;
+    if (!this->update_scheduled_(scheduled, !std::isnan(value)))
+      return;
+  } else if (!this->publishing_ && !this->priority_)
     return;
 
-  text_sensor->publish_state(state);
+  sensor->publish_state(value);
+  this->publishes_++;
 }
 
-void VictronComponent::publish_state_once_(text_sensor::TextSensor *text_sensor, const std::string &state) {
+void VictronComponent::publish_state_(text_sensor::TextSensor *text_sensor, const std::string &state) {
   if (text_sensor == nullptr)
     return;
 
-  if (text_sensor->has_state())
+  ScheduledEntity *scheduled = this->find_scheduled_(text_sensor);
+  if (scheduled != nullptr) {
+    scheduled->text = state;
+    if (!this->update_scheduled_(scheduled, true))
+      return;
+  } else if (!this->publishing_ && !this->priority_)
     return;
 
   text_sensor->publish_state(state);
+  this->publishes_++;
 }
 
 }  // namespace victron
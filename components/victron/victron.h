@@ -1,17 +1,48 @@
 #pragma once
 
+#include "esphome/core/automation.h"
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/text_sensor/text_sensor.h"
 #include "esphome/components/uart/uart.h"
+#include "frame.h"
+#include "frame_assembler.h"
+#include "spsc_ring.h"
+#include "trace.h"
+
+#include <vector>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
 
 namespace esphome {
 namespace victron {
 
+/// Health counters of the serial link since boot.
+struct LinkStats {
+  uint32_t frames;
+  uint32_t frames_repeated;
+  uint32_t frames_dropped;
+  uint32_t checksum_errors;
+  uint32_t rx_timeouts;
+};
+
 class VictronComponent : public uart::UARTDevice, public Component {
  public:
   void set_throttle(uint32_t throttle) { this->throttle_ = throttle; }
+  void set_rx_task(bool rx_task) { this->rx_task_ = rx_task; }
+  void set_fast_alarms(bool fast_alarms) { this->fast_alarms_ = fast_alarms; }
+  void set_heartbeat(uint32_t heartbeat) { this->heartbeat_ = heartbeat; }
+  void set_publish_budget(uint16_t publish_budget) { this->publish_budget_ = publish_budget; }
+  void set_idle_poll_interval(uint32_t idle_poll_interval) { this->idle_poll_interval_ = idle_poll_interval; }
+  /// Start or stop reading the UART, e.g. if it is shared with other devices by a multiplexer.
+  void set_rx_enabled(bool rx_enabled);
+  /// Write an 8 bit register with a HEX protocol Set command. Needs the TX pin of the UART.
+  void set_register(uint16_t address, uint8_t value);
   void set_load_state_binary_sensor(binary_sensor::BinarySensor *load_state_binary_sensor) {
     load_state_binary_sensor_ = load_state_binary_sensor;
   }
@@ -175,6 +206,15 @@ class VictronComponent : public uart::UARTDevice, public Component {
     amount_of_charged_energy_sensor_ = amount_of_charged_energy_sensor;
   }
 
+  void set_battery_power_sensor(sensor::Sensor *battery_power_sensor) { battery_power_sensor_ = battery_power_sensor; }
+  void set_charger_efficiency_sensor(sensor::Sensor *charger_efficiency_sensor) {
+    charger_efficiency_sensor_ = charger_efficiency_sensor;
+  }
+  void set_load_power_sensor(sensor::Sensor *load_power_sensor) { load_power_sensor_ = load_power_sensor; }
+  void set_midpoint_balance_sensor(sensor::Sensor *midpoint_balance_sensor) {
+    midpoint_balance_sensor_ = midpoint_balance_sensor;
+  }
+
   void set_alarm_condition_active_text_sensor(text_sensor::TextSensor *alarm_condition_active_text_sensor) {
     alarm_condition_active_text_sensor_ = alarm_condition_active_text_sensor;
   }
@@ -185,17 +225,92 @@ class VictronComponent : public uart::UARTDevice, public Component {
     model_description_text_sensor_ = model_description_text_sensor;
   }
 
+  void add_custom_field(const std::string &label, FieldType type, float scale, float offset, sensor::Sensor *sensor);
+  void add_custom_field(const std::string &label, binary_sensor::BinarySensor *binary_sensor);
+  void add_custom_field(const std::string &label, text_sensor::TextSensor *text_sensor);
+
+  void set_update_interval(sensor::Sensor *sensor, uint32_t update_interval);
+  void set_update_interval(text_sensor::TextSensor *text_sensor, uint32_t update_interval);
+  void set_update_interval(binary_sensor::BinarySensor *binary_sensor, uint32_t update_interval);
+
+  /// Typed values of the last committed frame.
+  const Frame &get_frame() const { return this->frame_; }
+  LinkStats get_link_stats() const;
+  /// Log the parser event trace and the latency histogram (if compiled in with `trace: true`).
+  void dump_trace();
+  void add_on_frame_callback(std::function<void(const Frame &)> &&callback) {
+    this->frame_callback_.add(std::move(callback));
+  }
+
+  void setup() override;
   void dump_config() override;
   void loop() override;
 
   float get_setup_priority() const override { return setup_priority::DATA; }
 
  protected:
-  void handle_value_();
+  // An entity published on its own update interval instead of every published frame
+  struct ScheduledEntity {
+    // The sensor, text sensor or binary sensor, scheduled_ is sorted by it
+    const void *entity{nullptr};
+    sensor::Sensor *sensor{nullptr};
+    text_sensor::TextSensor *text_sensor{nullptr};
+    binary_sensor::BinarySensor *binary_sensor{nullptr};
+    uint32_t interval{0};
+    uint32_t next_due{0};
+    // Latest state, published when the entity is due
+    float value{NAN};
+    std::string text;
+    bool state{false};
+    // A valid value was received, the first one is published right away
+    bool has_value{false};
+  };
+
+  // A label mapped to an entity by the user, decoded into the slot of the same index of custom_
+  struct CustomField {
+    char label[MAX_LABEL_LENGTH + 1];
+    FieldType type{TYPE_INT};
+    float scale{1.0f};
+    float offset{0.0f};
+    sensor::Sensor *sensor{nullptr};
+    binary_sensor::BinarySensor *binary_sensor{nullptr};
+    text_sensor::TextSensor *text_sensor{nullptr};
+  };
+
+  // Sensors calculated from several fields
+  enum DerivedSensor : uint8_t {
+    DERIVED_BATTERY_POWER,
+    DERIVED_CHARGER_EFFICIENCY,
+    DERIVED_LOAD_POWER,
+    DERIVED_MIDPOINT_BALANCE,
+    DERIVED_COUNT,
+  };
+
+  // Last block of a kind (by its first label), a BMV alternates between two blocks
+  struct BlockFingerprint {
+    char label[MAX_LABEL_LENGTH + 1];
+    uint32_t fingerprint{0};
+    uint64_t received{0};
+    uint64_t custom_received{0};
+  };
+
+  void receive_();
+  void commit_frame_();
+  void handle_frame_(const RawFrame &frame);
+  bool is_repeated_(const RawFrame &frame);
+  bool has_pending_() const { return (this->pending_ | this->derived_pending_ | this->custom_pending_) != 0; }
+  void publish_pending_();
+  void publish_field_(FrameField field);
+  void publish_custom_(uint8_t slot);
+  void log_unhandled_(const RawField &field);
+  void publish_derived_(DerivedSensor derived);
+  ScheduledEntity *find_scheduled_(const void *entity);
+  bool update_scheduled_(ScheduledEntity *scheduled, bool valid);
+  bool is_due_later_(uint16_t a, uint16_t b) const;
+  void publish_scheduled_();
   void publish_state_(binary_sensor::BinarySensor *binary_sensor, const bool &state);
   void publish_state_(sensor::Sensor *sensor, float value);
   void publish_state_(text_sensor::TextSensor *text_sensor, const std::string &state);
-  void publish_state_once_(text_sensor::TextSensor *text_sensor, const std::string &state);
 
   binary_sensor::BinarySensor *load_state_binary_sensor_;
   binary_sensor::BinarySensor *relay_state_binary_sensor_;
@@ -259,17 +374,101 @@ class VictronComponent : public uart::UARTDevice, public Component {
   sensor::Sensor *max_auxiliary_battery_voltage_sensor_{nullptr};
   sensor::Sensor *amount_of_discharged_energy_sensor_{nullptr};
   sensor::Sensor *amount_of_charged_energy_sensor_{nullptr};
+  sensor::Sensor *battery_power_sensor_{nullptr};
+  sensor::Sensor *charger_efficiency_sensor_{nullptr};
+  sensor::Sensor *load_power_sensor_{nullptr};
+  sensor::Sensor *midpoint_balance_sensor_{nullptr};
   text_sensor::TextSensor *alarm_condition_active_text_sensor_{nullptr};
   text_sensor::TextSensor *alarm_reason_text_sensor_{nullptr};
   text_sensor::TextSensor *model_description_text_sensor_{nullptr};
 
+  std::vector<CustomField> custom_fields_;
+  // Unknown labels are logged once per boot
+  std::vector<std::string> unhandled_labels_;
+  std::vector<ScheduledEntity> scheduled_;
+  // Min-heap of indices into scheduled_ by the due time
+  std::vector<uint16_t> schedule_;
+  // A due time was moved by a first value, the heap is rebuilt
+  bool schedule_changed_{false};
+
+  FrameAssembler assembler_;
+  BlockFingerprint fingerprints_[2]{};
+  uint8_t next_fingerprint_{0};
+  uint32_t heartbeat_{0};
+  uint32_t frames_{0};
+  uint32_t frames_repeated_{0};
+  Frame frame_{};
+  FieldMemo memo_{};
+  CustomFrame custom_{};
+  // Fields changed since they were published last
+  uint64_t dirty_{0};
+  uint8_t derived_dirty_{0};
+  uint64_t custom_dirty_{0};
+  // Fields to publish by the next loop() iterations
+  uint64_t pending_{0};
+  uint64_t pending_alarms_{0};
+  uint8_t derived_pending_{0};
+  uint64_t custom_pending_{0};
+  // Max. number of states published per loop() iteration, 0 = unlimited
+  uint16_t publish_budget_{0};
+  uint16_t publishes_{0};
+  uint32_t last_heartbeat_{0};
+  CallbackManager<void(const Frame &)> frame_callback_;
   bool publishing_{true};
-  int state_{0};
-  std::string label_;
-  std::string value_;
+  // Publish the current field immediately, bypassing the throttle and the update intervals
+  bool priority_{false};
+  bool fast_alarms_{true};
   uint32_t last_transmission_{0};
   uint32_t last_publish_{0};
   uint32_t throttle_{0};
+  uint32_t idle_poll_interval_{0};
+  uint32_t last_poll_{0};
+  bool rx_active_{false};
+  bool rx_enabled_{true};
+  // Discard everything up to the next pause, the UART was connected to another device before
+  bool rx_resync_{false};
+  // Written by the receiver only (the RX task if enabled)
+  uint32_t rx_timeouts_{0};
+  uint32_t rx_timeouts_logged_{0};
+  uint32_t frames_dropped_{0};
+  uint32_t frames_dropped_logged_{0};
+  uint32_t checksum_errors_logged_{0};
+
+#ifdef USE_VICTRON_TRACE
+  TraceRing trace_;
+  uint32_t trace_checksum_errors_{0};
+  // Arrival of the first byte of the last frame, in micros()
+  uint32_t trace_frame_start_{0};
+  // Start of the frame being published, the latency is recorded once everything is published
+  uint32_t trace_latency_start_{0};
+  bool trace_latency_pending_{false};
+#endif
+
+  bool rx_task_{false};
+#ifdef USE_ESP32
+  static void rx_task(void *arg);
+
+  RawFrame rx_frame_;
+  SpscRing<RawFrame, 4> *frame_queue_{nullptr};
+  TaskHandle_t rx_task_handle_{nullptr};
+#endif
+};
+
+class FrameTrigger : public Trigger<const Frame &> {
+ public:
+  explicit FrameTrigger(VictronComponent *parent) {
+    parent->add_on_frame_callback([this](const Frame &frame) { this->trigger(frame); });
+  }
+};
+
+template<typename... Ts> class DumpTraceAction : public Action<Ts...> {
+ public:
+  explicit DumpTraceAction(VictronComponent *parent) : parent_(parent) {}
+
+  void play(Ts... x) override { this->parent_->dump_trace(); }
+
+ protected:
+  VictronComponent *parent_;
 };
 
 }  // namespace victron
@@ -0,0 +1,40 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID, CONF_THROTTLE, CONF_TIMEOUT
+
+from esphome.components.victron import VictronComponent
+
+AUTO_LOAD = ["sensor"]
+
+DEPENDENCIES = ["victron"]
+
+MULTI_CONF = True
+
+victron_aggregate_ns = cg.esphome_ns.namespace("victron_aggregate")
+VictronAggregate = victron_aggregate_ns.class_("VictronAggregate", cg.Component)
+
+CONF_VICTRON_AGGREGATE_ID = "victron_aggregate_id"
+CONF_VICTRON_IDS = "victron_ids"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(VictronAggregate),
+        cv.Required(CONF_VICTRON_IDS): cv.All(
+            cv.ensure_list(cv.use_id(VictronComponent)), cv.Length(min=1)
+        ),
+        cv.Optional(CONF_THROTTLE, default="1s"): cv.positive_time_period_milliseconds,
+        # Long enough for the rounds of a victron_mux
+        cv.Optional(CONF_TIMEOUT, default="30s"): cv.positive_time_period_milliseconds,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    cg.add(var.set_throttle(config[CONF_THROTTLE]))
+    cg.add(var.set_timeout(config[CONF_TIMEOUT]))
+    for victron_id in config[CONF_VICTRON_IDS]:
+        member = yield cg.get_variable(victron_id)
+        cg.add(var.add_member(member))
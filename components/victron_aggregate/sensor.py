@@ -0,0 +1,104 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    DEVICE_CLASS_CURRENT,
+    DEVICE_CLASS_EMPTY,
+    DEVICE_CLASS_POWER,
+    ICON_CURRENT_AC,
+    ICON_EMPTY,
+    ICON_POWER,
+    UNIT_AMPERE,
+    UNIT_EMPTY,
+    UNIT_WATT,
+    UNIT_WATT_HOURS,
+)
+
+from . import CONF_VICTRON_AGGREGATE_ID, VictronAggregate
+
+DEPENDENCIES = ["victron_aggregate"]
+
+CODEOWNERS = ["@KinDR007"]
+
+CONF_PANEL_POWER = "panel_power"
+CONF_BATTERY_CURRENT = "battery_current"
+CONF_LOAD_CURRENT = "load_current"
+CONF_YIELD_TODAY = "yield_today"
+CONF_YIELD_YESTERDAY = "yield_yesterday"
+CONF_YIELD_TOTAL = "yield_total"
+CONF_ERROR_CODE = "error_code"
+CONF_CHARGING_MODE_ID = "charging_mode_id"
+
+SENSORS = [
+    CONF_PANEL_POWER,
+    CONF_BATTERY_CURRENT,
+    CONF_LOAD_CURRENT,
+    CONF_YIELD_TODAY,
+    CONF_YIELD_YESTERDAY,
+    CONF_YIELD_TOTAL,
+    CONF_ERROR_CODE,
+    CONF_CHARGING_MODE_ID,
+]
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_VICTRON_AGGREGATE_ID): cv.use_id(VictronAggregate),
+        cv.Optional(CONF_PANEL_POWER): sensor.sensor_schema(
+            unit_of_measurement=UNIT_WATT,
+            icon=ICON_POWER,
+            accuracy_decimals=0,
+            device_class=DEVICE_CLASS_POWER,
+        ),
+        cv.Optional(CONF_BATTERY_CURRENT): sensor.sensor_schema(
+            unit_of_measurement=UNIT_AMPERE,
+            icon=ICON_CURRENT_AC,
+            accuracy_decimals=3,
+            device_class=DEVICE_CLASS_CURRENT,
+        ),
+        cv.Optional(CONF_LOAD_CURRENT): sensor.sensor_schema(
+            unit_of_measurement=UNIT_AMPERE,
+            icon=ICON_CURRENT_AC,
+            accuracy_decimals=3,
+            device_class=DEVICE_CLASS_CURRENT,
+        ),
+        cv.Optional(CONF_YIELD_TODAY): sensor.sensor_schema(
+            unit_of_measurement=UNIT_WATT_HOURS,
+            icon=ICON_POWER,
+            accuracy_decimals=0,
+            device_class=DEVICE_CLASS_POWER,
+        ),
+        cv.Optional(CONF_YIELD_YESTERDAY): sensor.sensor_schema(
+            unit_of_measurement=UNIT_WATT_HOURS,
+            icon=ICON_POWER,
+            accuracy_decimals=0,
+            device_class=DEVICE_CLASS_POWER,
+        ),
+        cv.Optional(CONF_YIELD_TOTAL): sensor.sensor_schema(
+            unit_of_measurement=UNIT_WATT_HOURS,
+            icon=ICON_POWER,
+            accuracy_decimals=0,
+            device_class=DEVICE_CLASS_POWER,
+        ),
+        cv.Optional(CONF_ERROR_CODE): sensor.sensor_schema(
+            unit_of_measurement=UNIT_EMPTY,
+            icon=ICON_EMPTY,
+            accuracy_decimals=0,
+            device_class=DEVICE_CLASS_EMPTY,
+        ),
+        cv.Optional(CONF_CHARGING_MODE_ID): sensor.sensor_schema(
+            unit_of_measurement=UNIT_EMPTY,
+            icon=ICON_EMPTY,
+            accuracy_decimals=0,
+            device_class=DEVICE_CLASS_EMPTY,
+        ),
+    }
+)
+
+
+def to_code(config):
+    hub = yield cg.get_variable(config[CONF_VICTRON_AGGREGATE_ID])
+    for key in SENSORS:
+        if key in config:
+            conf = config[key]
+            sens = yield sensor.new_sensor(conf)
+            cg.add(getattr(hub, f"set_{key}_sensor")(sens))
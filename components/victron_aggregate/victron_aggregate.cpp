@@ -0,0 +1,185 @@
+#include "victron_aggregate.h"
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+
+namespace esphome {
+namespace victron_aggregate {
+
+static const char *const TAG = "victron_aggregate";
+
+static const int32_t CHARGING_MODE_FAULT = 2;
+// Charging states (CS) from the least to the most advanced, other states are ignored
+static const int32_t CHARGING_MODE_ORDER[] = {
+    0,    // Off
+    245,  // Starting-up
+    252,  // External control
+    9,    // Inverting
+    11,   // Power supply
+    3,    // Bulk
+    4,    // Absorption
+    246,  // Repeated absorption
+    248,  // BatterySafe
+    7,    // Equalize (manual)
+    247,  // Auto equalize / Recondition
+    5,    // Float
+    6,    // Storage
+};
+
+static int8_t charging_mode_rank(int32_t charging_mode) {
+  for (uint8_t rank = 0; rank < sizeof(CHARGING_MODE_ORDER) / sizeof(CHARGING_MODE_ORDER[0]); rank++) {
+    if (CHARGING_MODE_ORDER[rank] == charging_mode)
+      return rank;
+  }
+  return -1;
+}
+
+// Indexed by Sum
+static const victron::FrameField SUM_FIELDS[] = {
+    victron::FIELD_PANEL_POWER,     victron::FIELD_BATTERY_CURRENT, victron::FIELD_LOAD_CURRENT,
+    victron::FIELD_YIELD_TODAY,     victron::FIELD_YIELD_YESTERDAY, victron::FIELD_YIELD_TOTAL,
+};
+
+static const uint64_t AGGREGATED_FIELDS =
+    victron::field_bit(victron::FIELD_PANEL_POWER) | victron::field_bit(victron::FIELD_BATTERY_CURRENT) |
+    victron::field_bit(victron::FIELD_LOAD_CURRENT) | victron::field_bit(victron::FIELD_YIELD_TODAY) |
+    victron::field_bit(victron::FIELD_YIELD_YESTERDAY) | victron::field_bit(victron::FIELD_YIELD_TOTAL) |
+    victron::field_bit(victron::FIELD_ERROR_CODE) | victron::field_bit(victron::FIELD_CHARGING_MODE);
+
+void VictronAggregate::add_member(victron::VictronComponent *member) {
+  const size_t index = this->members_.size();
+  this->members_.emplace_back();
+  member->add_on_frame_callback([this, index](const victron::Frame &frame) { this->update_(index, frame); });
+}
+
+void VictronAggregate::dump_config() {
+  ESP_LOGCONFIG(TAG, "Victron Aggregate:");
+  ESP_LOGCONFIG(TAG, "  Members: %u", (unsigned) this->members_.size());
+  ESP_LOGCONFIG(TAG, "  Timeout: %" PRIu32 " ms", this->timeout_);
+  LOG_SENSOR("  ", "Panel Power", panel_power_sensor_);
+  LOG_SENSOR("  ", "Battery Current", battery_current_sensor_);
+  LOG_SENSOR("  ", "Load Current", load_current_sensor_);
+  LOG_SENSOR("  ", "Yield Today", yield_today_sensor_);
+  LOG_SENSOR("  ", "Yield Yesterday", yield_yesterday_sensor_);
+  LOG_SENSOR("  ", "Yield Total", yield_total_sensor_);
+  LOG_SENSOR("  ", "Error Code", error_code_sensor_);
+  LOG_SENSOR("  ", "Charging Mode ID", charging_mode_id_sensor_);
+}
+
+// Called by the member for every committed frame
+void VictronAggregate::update_(size_t index, const victron::Frame &frame) {
+  Member &member = this->members_[index];
+  member.last_frame = millis();
+  // All values are taken over again after a timeout, also the unchanged ones
+  const uint64_t changed = member.active ? frame.changed : frame.valid;
+  member.active = true;
+  if ((changed & AGGREGATED_FIELDS) == 0)
+    return;
+
+  for (uint8_t sum = 0; sum < SUM_COUNT; sum++) {
+    const victron::FrameField field = SUM_FIELDS[sum];
+    if (!(changed & victron::field_bit(field)))
+      continue;
+
+    // Replace the old contribution of the member
+    const uint8_t bit = 1 << sum;
+    if (member.valid & bit) {
+      this->sums_[sum] -= member.values[sum];
+      this->contributors_[sum]--;
+    }
+    if (frame.has(field)) {
+      member.values[sum] = frame.get(field);
+      member.valid |= bit;
+      this->sums_[sum] += member.values[sum];
+      this->contributors_[sum]++;
+    } else {
+      member.valid &= ~bit;
+    }
+  }
+
+  if (changed & victron::field_bit(victron::FIELD_ERROR_CODE))
+    member.error_code = frame.has(victron::FIELD_ERROR_CODE) ? frame.get(victron::FIELD_ERROR_CODE) : 0;
+  if (changed & victron::field_bit(victron::FIELD_CHARGING_MODE))
+    member.charging_mode = frame.has(victron::FIELD_CHARGING_MODE) ? frame.get(victron::FIELD_CHARGING_MODE) : -1;
+
+  this->dirty_ = true;
+}
+
+// Removes the contribution of a member which stopped sending
+void VictronAggregate::expire_(Member &member) {
+  for (uint8_t sum = 0; sum < SUM_COUNT; sum++) {
+    if (member.valid & (1 << sum)) {
+      this->sums_[sum] -= member.values[sum];
+      this->contributors_[sum]--;
+    }
+  }
+  member.valid = 0;
+  member.error_code = 0;
+  member.charging_mode = -1;
+  member.active = false;
+  this->dirty_ = true;
+}
+
+void VictronAggregate::loop() {
+  const uint32_t now = millis();
+  for (size_t i = 0; i < this->members_.size(); i++) {
+    Member &member = this->members_[i];
+    if (member.active && now - member.last_frame >= this->timeout_) {
+      ESP_LOGW(TAG, "No frame of member %u for %" PRIu32 " ms, left out of the totals", (unsigned) i, this->timeout_);
+      this->expire_(member);
+    }
+  }
+
+  if (!this->dirty_)
+    return;
+
+  if (now - this->last_publish_ < this->throttle_)
+    return;
+  this->last_publish_ = now;
+  this->dirty_ = false;
+
+  this->publish_sum_(this->panel_power_sensor_, SUM_PANEL_POWER, 1.0f);
+  // mA to A
+  this->publish_sum_(this->battery_current_sensor_, SUM_BATTERY_CURRENT, 0.001f);
+  this->publish_sum_(this->load_current_sensor_, SUM_LOAD_CURRENT, 0.001f);
+  // 0.01 kWh to Wh
+  this->publish_sum_(this->yield_today_sensor_, SUM_YIELD_TODAY, 10.0f);
+  this->publish_sum_(this->yield_yesterday_sensor_, SUM_YIELD_YESTERDAY, 10.0f);
+  this->publish_sum_(this->yield_total_sensor_, SUM_YIELD_TOTAL, 10.0f);
+
+  // Worst case: the first error of any member, Fault if any member is in Fault, otherwise the
+  // least advanced charging state
+  int32_t error_code = 0;
+  int32_t charging_mode = -1;
+  int8_t charging_rank = 0;
+  for (const auto &member : this->members_) {
+    if (error_code == 0)
+      error_code = member.error_code;
+    if (member.charging_mode < 0 || charging_mode == CHARGING_MODE_FAULT)
+      continue;
+    if (member.charging_mode == CHARGING_MODE_FAULT) {
+      charging_mode = CHARGING_MODE_FAULT;
+      continue;
+    }
+    const int8_t rank = charging_mode_rank(member.charging_mode);
+    if (rank >= 0 && (charging_mode < 0 || rank < charging_rank)) {
+      charging_mode = member.charging_mode;
+      charging_rank = rank;
+    }
+  }
+
+  if (this->error_code_sensor_ != nullptr)
+    this->error_code_sensor_->publish_state(error_code);
+  if (this->charging_mode_id_sensor_ != nullptr)
+    this->charging_mode_id_sensor_->publish_state(charging_mode >= 0 ? charging_mode : NAN);
+}
+
+void VictronAggregate::publish_sum_(sensor::Sensor *sensor, Sum sum, float factor) {
+  if (sensor == nullptr)
+    return;
+  // No member left (all timed out)
+  sensor->publish_state(this->contributors_[sum] > 0 ? this->sums_[sum] * factor : NAN);
+}
+
+}  // namespace victron_aggregate
+}  // namespace esphome
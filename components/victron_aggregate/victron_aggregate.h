@@ -0,0 +1,87 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/victron/victron.h"
+
+#include <vector>
+
+namespace esphome {
+namespace victron_aggregate {
+
+/// Combines the frames of several victron devices (e.g. parallel chargers on one battery bank) into site totals.
+class VictronAggregate : public Component {
+ public:
+  void add_member(victron::VictronComponent *member);
+  void set_throttle(uint32_t throttle) { this->throttle_ = throttle; }
+  /// A member without a frame for this long is left out of the totals.
+  void set_timeout(uint32_t timeout) { this->timeout_ = timeout; }
+
+  void set_panel_power_sensor(sensor::Sensor *panel_power_sensor) { panel_power_sensor_ = panel_power_sensor; }
+  void set_battery_current_sensor(sensor::Sensor *battery_current_sensor) {
+    battery_current_sensor_ = battery_current_sensor;
+  }
+  void set_load_current_sensor(sensor::Sensor *load_current_sensor) { load_current_sensor_ = load_current_sensor; }
+  void set_yield_today_sensor(sensor::Sensor *yield_today_sensor) { yield_today_sensor_ = yield_today_sensor; }
+  void set_yield_yesterday_sensor(sensor::Sensor *yield_yesterday_sensor) {
+    yield_yesterday_sensor_ = yield_yesterday_sensor;
+  }
+  void set_yield_total_sensor(sensor::Sensor *yield_total_sensor) { yield_total_sensor_ = yield_total_sensor; }
+  void set_error_code_sensor(sensor::Sensor *error_code_sensor) { error_code_sensor_ = error_code_sensor; }
+  void set_charging_mode_id_sensor(sensor::Sensor *charging_mode_id_sensor) {
+    charging_mode_id_sensor_ = charging_mode_id_sensor;
+  }
+
+  void dump_config() override;
+  void loop() override;
+
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+ protected:
+  // Fields summed up across the members
+  enum Sum : uint8_t {
+    SUM_PANEL_POWER,
+    SUM_BATTERY_CURRENT,
+    SUM_LOAD_CURRENT,
+    SUM_YIELD_TODAY,
+    SUM_YIELD_YESTERDAY,
+    SUM_YIELD_TOTAL,
+    SUM_COUNT,
+  };
+
+  struct Member {
+    // Contribution of the member to the sums, valid if the bit of the sum is set
+    int32_t values[SUM_COUNT]{};
+    uint8_t valid{0};
+    int32_t error_code{0};
+    int32_t charging_mode{-1};
+    uint32_t last_frame{0};
+    // False before the first frame and after a timeout
+    bool active{false};
+  };
+
+  void update_(size_t index, const victron::Frame &frame);
+  void expire_(Member &member);
+  void publish_sum_(sensor::Sensor *sensor, Sum sum, float factor);
+
+  std::vector<Member> members_;
+  int64_t sums_[SUM_COUNT]{};
+  // Number of members contributing to a sum
+  uint8_t contributors_[SUM_COUNT]{};
+  bool dirty_{false};
+  uint32_t throttle_{0};
+  uint32_t timeout_{0};
+  uint32_t last_publish_{0};
+
+  sensor::Sensor *panel_power_sensor_{nullptr};
+  sensor::Sensor *battery_current_sensor_{nullptr};
+  sensor::Sensor *load_current_sensor_{nullptr};
+  sensor::Sensor *yield_today_sensor_{nullptr};
+  sensor::Sensor *yield_yesterday_sensor_{nullptr};
+  sensor::Sensor *yield_total_sensor_{nullptr};
+  sensor::Sensor *error_code_sensor_{nullptr};
+  sensor::Sensor *charging_mode_id_sensor_{nullptr};
+};
+
+}  // namespace victron_aggregate
+}  // namespace esphome
@@ -0,0 +1,109 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+import esphome.final_validate as fv
+from esphome.components import output
+from esphome.const import CONF_ID, CONF_OUTPUT, CONF_TX_PIN, CONF_UART_ID
+
+from esphome.components.victron import CONF_VICTRON_ID, VictronComponent
+
+DEPENDENCIES = ["victron"]
+
+MULTI_CONF = True
+
+victron_load_control_ns = cg.esphome_ns.namespace("victron_load_control")
+VictronLoadControl = victron_load_control_ns.class_("VictronLoadControl", cg.Component)
+
+CONF_BATTERY_MONITOR_ID = "battery_monitor_id"
+CONF_OFF_BELOW_VOLTAGE = "off_below_voltage"
+CONF_ON_ABOVE_VOLTAGE = "on_above_voltage"
+CONF_OFF_BELOW_STATE_OF_CHARGE = "off_below_state_of_charge"
+CONF_ON_ABOVE_STATE_OF_CHARGE = "on_above_state_of_charge"
+CONF_OFF_DELAY = "off_delay"
+CONF_ON_DELAY = "on_delay"
+
+
+def validate_hysteresis(config):
+    for off, on in (
+        (CONF_OFF_BELOW_VOLTAGE, CONF_ON_ABOVE_VOLTAGE),
+        (CONF_OFF_BELOW_STATE_OF_CHARGE, CONF_ON_ABOVE_STATE_OF_CHARGE),
+    ):
+        if off in config and config[on] <= config[off]:
+            raise cv.Invalid(f"{on} has to be greater than {off}")
+    return config
+
+
+def final_validate_tx_pin(config):
+    # Without a relay the load output of the charger is switched by HEX commands
+    if CONF_OUTPUT in config:
+        return config
+    full_config = fv.full_config.get()
+    for victron_config in full_config.get("victron", []):
+        if str(victron_config[CONF_ID]) != str(config[CONF_VICTRON_ID]):
+            continue
+        for uart_config in full_config.get("uart", []):
+            if str(uart_config[CONF_ID]) == str(victron_config[CONF_UART_ID]) and CONF_TX_PIN not in uart_config:
+                raise cv.Invalid(
+                    f"The UART of {victron_config[CONF_ID]} needs a {CONF_TX_PIN} to switch the load output"
+                )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = final_validate_tx_pin
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(VictronLoadControl),
+            # The charger whose load output is switched
+            cv.GenerateID(CONF_VICTRON_ID): cv.use_id(VictronComponent),
+            # Source of the voltage and the state of charge, e.g. a BMV, defaults to the charger
+            cv.Optional(CONF_BATTERY_MONITOR_ID): cv.use_id(VictronComponent),
+            # A relay instead of the load output of the charger
+            cv.Optional(CONF_OUTPUT): cv.use_id(output.BinaryOutput),
+            cv.Optional(CONF_OFF_BELOW_VOLTAGE): cv.voltage,
+            cv.Optional(CONF_ON_ABOVE_VOLTAGE): cv.voltage,
+            cv.Optional(CONF_OFF_BELOW_STATE_OF_CHARGE): cv.percentage,
+            cv.Optional(CONF_ON_ABOVE_STATE_OF_CHARGE): cv.percentage,
+            cv.Optional(CONF_OFF_DELAY, default="10s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_ON_DELAY, default="60s"): cv.positive_time_period_milliseconds,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.has_at_least_one_key(CONF_OFF_BELOW_VOLTAGE, CONF_OFF_BELOW_STATE_OF_CHARGE),
+    cv.has_none_or_all_keys(CONF_OFF_BELOW_VOLTAGE, CONF_ON_ABOVE_VOLTAGE),
+    cv.has_none_or_all_keys(CONF_OFF_BELOW_STATE_OF_CHARGE, CONF_ON_ABOVE_STATE_OF_CHARGE),
+    validate_hysteresis,
+)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    victron = yield cg.get_variable(config[CONF_VICTRON_ID])
+    cg.add(var.set_victron(victron))
+    battery_monitor = yield cg.get_variable(
+        config.get(CONF_BATTERY_MONITOR_ID, config[CONF_VICTRON_ID])
+    )
+    cg.add(var.set_battery_monitor(battery_monitor))
+    if CONF_OUTPUT in config:
+        out = yield cg.get_variable(config[CONF_OUTPUT])
+        cg.add(var.set_output(out))
+
+    # Native units of the protocol: mV and per mill
+    if CONF_OFF_BELOW_VOLTAGE in config:
+        cg.add(
+            var.set_voltage_thresholds(
+                int(round(config[CONF_OFF_BELOW_VOLTAGE] * 1000)),
+                int(round(config[CONF_ON_ABOVE_VOLTAGE] * 1000)),
+            )
+        )
+    if CONF_OFF_BELOW_STATE_OF_CHARGE in config:
+        cg.add(
+            var.set_state_of_charge_thresholds(
+                int(round(config[CONF_OFF_BELOW_STATE_OF_CHARGE] * 1000)),
+                int(round(config[CONF_ON_ABOVE_STATE_OF_CHARGE] * 1000)),
+            )
+        )
+    cg.add(var.set_off_delay(config[CONF_OFF_DELAY]))
+    cg.add(var.set_on_delay(config[CONF_ON_DELAY]))
@@ -0,0 +1,137 @@
+#include "victron_load_control.h"
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+#include <utility>
+
+namespace esphome {
+namespace victron_load_control {
+
+static const char *const TAG = "victron_load_control";
+
+// Load output control: 0 = off, 1 = auto, 2 = alt1, 3 = alt2, 4 = on
+static const uint16_t REGISTER_LOAD_OUTPUT_CONTROL = 0xEDAB;
+static const uint8_t LOAD_OUTPUT_OFF = 0;
+static const uint8_t LOAD_OUTPUT_ON = 4;
+// The frame already on the wire while writing doesn't show the new state yet
+static const uint16_t CONFIRM_FRAMES = 3;
+static const uint8_t MAX_RETRIES = 3;
+// Afterwards the device stores every write, ~5 min at one frame per second
+static const uint16_t BACKOFF_FRAMES = 300;
+
+void VictronLoadControl::set_victron(victron::VictronComponent *victron) {
+  this->victron_ = victron;
+  victron->add_on_frame_callback([this](const victron::Frame &frame) { this->confirm_(frame); });
+}
+
+void VictronLoadControl::set_battery_monitor(victron::VictronComponent *battery_monitor) {
+  battery_monitor->add_on_frame_callback([this](const victron::Frame &frame) { this->evaluate_(frame); });
+}
+
+void VictronLoadControl::dump_config() {
+  ESP_LOGCONFIG(TAG, "Victron Load Control:");
+  ESP_LOGCONFIG(TAG, "  Switched by: %s", this->output_ != nullptr ? "output" : "HEX register write");
+  if (this->voltage_rule_.enabled) {
+    ESP_LOGCONFIG(TAG, "  Voltage: off below %" PRId32 " mV, on above %" PRId32 " mV", this->voltage_rule_.off,
+                  this->voltage_rule_.on);
+  }
+  if (this->state_of_charge_rule_.enabled) {
+    ESP_LOGCONFIG(TAG, "  State of charge: off below %.1f %%, on above %.1f %%", this->state_of_charge_rule_.off * 0.1f,
+                  this->state_of_charge_rule_.on * 0.1f);
+  }
+  ESP_LOGCONFIG(TAG, "  Off delay: %" PRIu32 " ms", this->off_delay_);
+  ESP_LOGCONFIG(TAG, "  On delay: %" PRIu32 " ms", this->on_delay_);
+}
+
+// Called for every committed frame of the battery monitor
+void VictronLoadControl::evaluate_(const victron::Frame &frame) {
+  // Low if any rule is low, high if all rules with a value are high
+  uint8_t rules = 0;
+  uint8_t low = 0;
+  uint8_t high = 0;
+  const std::pair<const Rule *, victron::FrameField> inputs[] = {
+      {&this->voltage_rule_, victron::FIELD_BATTERY_VOLTAGE},
+      {&this->state_of_charge_rule_, victron::FIELD_STATE_OF_CHARGE},
+  };
+  for (const auto &input : inputs) {
+    const Rule &rule = *input.first;
+    if (!rule.enabled || !frame.has(input.second))
+      continue;
+    const int32_t value = frame.get(input.second);
+    rules++;
+    if (value < rule.off)
+      low++;
+    if (value > rule.on)
+      high++;
+  }
+
+  Condition condition = CONDITION_NORMAL;
+  if (rules == 0) {
+    condition = CONDITION_UNKNOWN;
+  } else if (low > 0) {
+    condition = CONDITION_LOW;
+  } else if (high == rules) {
+    condition = CONDITION_HIGH;
+  }
+
+  const uint32_t now = millis();
+  if (condition != this->condition_) {
+    this->condition_ = condition;
+    this->condition_since_ = now;
+  }
+
+  if (condition == CONDITION_LOW && (!this->controlling_ || this->load_on_) &&
+      now - this->condition_since_ >= this->off_delay_) {
+    this->switch_load_(false);
+  } else if (condition == CONDITION_HIGH && (!this->controlling_ || !this->load_on_) &&
+             now - this->condition_since_ >= this->on_delay_) {
+    this->switch_load_(true);
+  }
+}
+
+// Called for every committed frame of the charger
+void VictronLoadControl::confirm_(const victron::Frame &frame) {
+  if (!this->confirming_ || !frame.has(victron::FIELD_LOAD_STATE))
+    return;
+
+  if ((frame.get(victron::FIELD_LOAD_STATE) != 0) == this->load_on_) {
+    ESP_LOGD(TAG, "Load output %s confirmed", ONOFF(this->load_on_));
+    this->confirming_ = false;
+    return;
+  }
+  const bool backing_off = this->retries_ > MAX_RETRIES;
+  if (++this->unconfirmed_frames_ < (backing_off ? BACKOFF_FRAMES : CONFIRM_FRAMES))
+    return;
+
+  // Lost command, no TX line or the device rejected the write
+  if (this->retries_ < MAX_RETRIES) {
+    this->retries_++;
+    ESP_LOGW(TAG, "Load output still not %s, retry %u of %u", ONOFF(this->load_on_), this->retries_, MAX_RETRIES);
+  } else if (!backing_off) {
+    this->retries_++;
+    ESP_LOGE(TAG, "Load output not switched %s after %u retries, retrying every %u frames", ONOFF(this->load_on_),
+             MAX_RETRIES, BACKOFF_FRAMES);
+  }
+  this->send_();
+}
+
+void VictronLoadControl::switch_load_(bool on) {
+  ESP_LOGI(TAG, "Switching the load output %s", ONOFF(on));
+  this->controlling_ = true;
+  this->load_on_ = on;
+  this->retries_ = 0;
+  if (this->output_ != nullptr) {
+    this->output_->set_state(on);
+    return;
+  }
+  this->confirming_ = true;
+  this->send_();
+}
+
+void VictronLoadControl::send_() {
+  this->unconfirmed_frames_ = 0;
+  this->victron_->set_register(REGISTER_LOAD_OUTPUT_CONTROL, this->load_on_ ? LOAD_OUTPUT_ON : LOAD_OUTPUT_OFF);
+}
+
+}  // namespace victron_load_control
+}  // namespace esphome
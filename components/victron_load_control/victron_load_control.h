@@ -0,0 +1,72 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/output/binary_output.h"
+#include "esphome/components/victron/victron.h"
+
+namespace esphome {
+namespace victron_load_control {
+
+/// Switches the load output of a charger by hysteresis rules on the battery voltage and the state of charge.
+///
+/// The rules are evaluated for every frame of the battery monitor (the charger itself by default). The load is
+/// switched off once any rule is below its off threshold for the off delay and on again once all rules are above
+/// their on threshold for the on delay. The charger is switched by a HEX register write confirmed by the `LOAD`
+/// field of its next frames, or an output drives a relay instead.
+class VictronLoadControl : public Component {
+ public:
+  void set_victron(victron::VictronComponent *victron);
+  void set_battery_monitor(victron::VictronComponent *battery_monitor);
+  void set_output(output::BinaryOutput *output) { this->output_ = output; }
+  /// mV
+  void set_voltage_thresholds(int32_t off, int32_t on) { this->voltage_rule_ = Rule{true, off, on}; }
+  /// Per mill
+  void set_state_of_charge_thresholds(int32_t off, int32_t on) { this->state_of_charge_rule_ = Rule{true, off, on}; }
+  void set_off_delay(uint32_t off_delay) { this->off_delay_ = off_delay; }
+  void set_on_delay(uint32_t on_delay) { this->on_delay_ = on_delay; }
+
+  void dump_config() override;
+
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+ protected:
+  struct Rule {
+    bool enabled;
+    int32_t off;
+    int32_t on;
+  };
+
+  enum Condition : uint8_t {
+    CONDITION_UNKNOWN,
+    CONDITION_LOW,
+    CONDITION_NORMAL,
+    CONDITION_HIGH,
+  };
+
+  void evaluate_(const victron::Frame &frame);
+  void confirm_(const victron::Frame &frame);
+  void switch_load_(bool on);
+  void send_();
+
+  victron::VictronComponent *victron_{nullptr};
+  output::BinaryOutput *output_{nullptr};
+  Rule voltage_rule_{false, 0, 0};
+  Rule state_of_charge_rule_{false, 0, 0};
+  uint32_t off_delay_{0};
+  uint32_t on_delay_{0};
+
+  Condition condition_{CONDITION_UNKNOWN};
+  // Start of the current low or high condition
+  uint32_t condition_since_{0};
+  // Nothing is switched before the first rule fired
+  bool controlling_{false};
+  bool load_on_{false};
+  // Frames of the charger received since the last write without the expected `LOAD` state
+  uint16_t unconfirmed_frames_{0};
+  bool confirming_{false};
+  // MAX_RETRIES + 1 once the failure was reported, the writes are backed off from then on
+  uint8_t retries_{0};
+};
+
+}  // namespace victron_load_control
+}  // namespace esphome
@@ -0,0 +1,76 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+import esphome.final_validate as fv
+from esphome import pins
+from esphome.const import CONF_ID
+
+from esphome.components.victron import CONF_RX_TASK, VictronComponent
+
+DEPENDENCIES = ["victron"]
+
+MULTI_CONF = True
+
+victron_mux_ns = cg.esphome_ns.namespace("victron_mux")
+VictronMux = victron_mux_ns.class_("VictronMux", cg.Component)
+
+CONF_SELECT_PINS = "select_pins"
+CONF_VICTRON_IDS = "victron_ids"
+CONF_DWELL_TIMEOUT = "dwell_timeout"
+
+
+def validate_channels(config):
+    # The position in the list is the channel of the mux
+    if len(config[CONF_VICTRON_IDS]) > 1 << len(config[CONF_SELECT_PINS]):
+        raise cv.Invalid(
+            f"{len(config[CONF_SELECT_PINS])} select pin(s) address at most "
+            f"{1 << len(config[CONF_SELECT_PINS])} devices"
+        )
+    return config
+
+
+def final_validate_rx_task(config):
+    # The mux switches the devices from the main loop, an RX task would keep reading meanwhile
+    muxed = {str(victron_id) for victron_id in config[CONF_VICTRON_IDS]}
+    for victron_config in fv.full_config.get().get("victron", []):
+        if str(victron_config[CONF_ID]) in muxed and victron_config.get(CONF_RX_TASK, False):
+            raise cv.Invalid(
+                f"{CONF_RX_TASK} isn't supported for {victron_config[CONF_ID]}, it is read via victron_mux"
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = final_validate_rx_task
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(VictronMux),
+            cv.Required(CONF_SELECT_PINS): cv.All(
+                cv.ensure_list(pins.gpio_output_pin_schema), cv.Length(min=1, max=4)
+            ),
+            cv.Required(CONF_VICTRON_IDS): cv.All(
+                cv.ensure_list(cv.use_id(VictronComponent)), cv.Length(min=2)
+            ),
+            # A device sends one frame per second
+            cv.Optional(CONF_DWELL_TIMEOUT, default="3s"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(min=cv.TimePeriod(milliseconds=1500)),
+            ),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    validate_channels,
+)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    cg.add(var.set_dwell_timeout(config[CONF_DWELL_TIMEOUT]))
+    for pin_config in config[CONF_SELECT_PINS]:
+        pin = yield cg.gpio_pin_expression(pin_config)
+        cg.add(var.add_select_pin(pin))
+    for victron_id in config[CONF_VICTRON_IDS]:
+        channel = yield cg.get_variable(victron_id)
+        cg.add(var.add_channel(channel))
@@ -0,0 +1,60 @@
+#include "victron_mux.h"
+#include "esphome/core/log.h"
+#include <cinttypes>
+
+namespace esphome {
+namespace victron_mux {
+
+static const char *const TAG = "victron_mux";
+
+void VictronMux::add_channel(victron::VictronComponent *device) {
+  const uint8_t channel = this->channels_.size();
+  this->channels_.push_back(device);
+  device->add_on_frame_callback([this, channel](const victron::Frame &frame) { this->on_frame_(channel); });
+}
+
+void VictronMux::setup() {
+  for (auto *pin : this->select_pins_)
+    pin->setup();
+  for (auto *device : this->channels_)
+    device->set_rx_enabled(false);
+  this->select_(0);
+}
+
+void VictronMux::dump_config() {
+  ESP_LOGCONFIG(TAG, "Victron Mux:");
+  for (uint8_t i = 0; i < this->select_pins_.size(); i++)
+    LOG_PIN("  Select Pin: ", this->select_pins_[i]);
+  ESP_LOGCONFIG(TAG, "  Channels: %u", (unsigned) this->channels_.size());
+  ESP_LOGCONFIG(TAG, "  Dwell timeout: %" PRIu32 " ms", this->dwell_timeout_);
+}
+
+void VictronMux::loop() {
+  if (millis() - this->selected_at_ < this->dwell_timeout_)
+    return;
+
+  // Nothing connected, powered off or only corrupted frames
+  this->timeouts_++;
+  ESP_LOGD(TAG, "No valid frame on channel %u, %" PRIu32 " timeout(s)", this->channel_, this->timeouts_);
+  this->select_((this->channel_ + 1) % this->channels_.size());
+}
+
+// Called for every frame committed by a device, i.e. after its checksum was verified
+void VictronMux::on_frame_(uint8_t channel) {
+  if (channel != this->channel_)
+    return;
+  this->select_((channel + 1) % this->channels_.size());
+}
+
+void VictronMux::select_(uint8_t channel) {
+  this->channels_[this->channel_]->set_rx_enabled(false);
+  for (uint8_t bit = 0; bit < this->select_pins_.size(); bit++)
+    this->select_pins_[bit]->digital_write((channel >> bit) & 1);
+  this->channel_ = channel;
+  this->selected_at_ = millis();
+  // The device resynchronizes on the next pause, switching in the middle of a frame is fine
+  this->channels_[channel]->set_rx_enabled(true);
+}
+
+}  // namespace victron_mux
+}  // namespace esphome
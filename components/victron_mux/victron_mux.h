@@ -0,0 +1,44 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/components/victron/victron.h"
+
+#include <vector>
+
+namespace esphome {
+namespace victron_mux {
+
+/// Shares one UART between several victron devices by driving the select lines of an analog multiplexer.
+///
+/// A channel stays selected until one checksum-valid frame of its device was received or the dwell timeout
+/// expired; all other devices don't read the UART meanwhile.
+class VictronMux : public Component {
+ public:
+  void add_select_pin(GPIOPin *pin) { this->select_pins_.push_back(pin); }
+  /// The channel of the mux is the position of the device.
+  void add_channel(victron::VictronComponent *device);
+  void set_dwell_timeout(uint32_t dwell_timeout) { this->dwell_timeout_ = dwell_timeout; }
+
+  void setup() override;
+  void dump_config() override;
+  void loop() override;
+
+  // Before the devices start reading
+  float get_setup_priority() const override { return setup_priority::HARDWARE; }
+
+ protected:
+  void on_frame_(uint8_t channel);
+  void select_(uint8_t channel);
+
+  std::vector<GPIOPin *> select_pins_;
+  std::vector<victron::VictronComponent *> channels_;
+  uint32_t dwell_timeout_{0};
+  uint32_t selected_at_{0};
+  // Channels skipped because their device didn't send a valid frame in time
+  uint32_t timeouts_{0};
+  uint8_t channel_{0};
+};
+
+}  // namespace victron_mux
+}  // namespace esphome
@@ -0,0 +1,39 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import web_server_base
+from esphome.components.web_server_base import CONF_WEB_SERVER_BASE_ID
+from esphome.const import CONF_ID, CONF_PATH
+
+from esphome.components.victron import VictronComponent
+
+AUTO_LOAD = ["web_server_base"]
+
+DEPENDENCIES = ["victron", "network"]
+
+victron_prometheus_ns = cg.esphome_ns.namespace("victron_prometheus")
+VictronPrometheus = victron_prometheus_ns.class_("VictronPrometheus", cg.Component)
+
+CONF_VICTRON_IDS = "victron_ids"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(VictronPrometheus),
+        cv.GenerateID(CONF_WEB_SERVER_BASE_ID): cv.use_id(web_server_base.WebServerBase),
+        cv.Required(CONF_VICTRON_IDS): cv.All(
+            cv.ensure_list(cv.use_id(VictronComponent)), cv.Length(min=1)
+        ),
+        cv.Optional(CONF_PATH, default="/metrics"): cv.All(cv.string_strict, cv.Length(min=1)),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    server = yield cg.get_variable(config[CONF_WEB_SERVER_BASE_ID])
+    var = cg.new_Pvariable(config[CONF_ID], server)
+    yield cg.register_component(var, config)
+
+    cg.add(var.set_path(config[CONF_PATH]))
+    for victron_id in config[CONF_VICTRON_IDS]:
+        device = yield cg.get_variable(victron_id)
+        # The id is the value of the "device" label
+        cg.add(var.add_device(device, str(victron_id)))
@@ -0,0 +1,241 @@
+#include "victron_prometheus.h"
+#include "esphome/core/log.h"
+#include <cinttypes>
+#include <cstdio>
+
+namespace esphome {
+namespace victron_prometheus {
+
+static const char *const TAG = "victron_prometheus";
+
+static const char *const CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+struct Metric {
+  // nullptr for text fields, which are part of victron_device_info
+  const char *name;
+  // The value of the protocol divided by 10^decimals is the value in the unit of the name
+  uint8_t decimals;
+};
+
+// Indexed by FrameField
+static const Metric METRICS[victron::FIELD_COUNT] = {
+    {"battery_voltage_volts", 3},
+    {"battery_voltage_2_volts", 3},
+    {"battery_voltage_3_volts", 3},
+    {"auxiliary_voltage_volts", 3},
+    {"midpoint_voltage_volts", 3},
+    {"midpoint_deviation_percent", 1},
+    {"panel_voltage_volts", 3},
+    {"panel_power_watts", 0},
+    {"battery_current_amperes", 3},
+    {"battery_current_2_amperes", 3},
+    {"battery_current_3_amperes", 3},
+    {"load_current_amperes", 3},
+    {"load_state", 0},
+    {"battery_temperature_celsius", 0},
+    {"instantaneous_power_watts", 0},
+    {"consumed_ampere_hours", 3},
+    {"state_of_charge_percent", 1},
+    {"time_to_go_minutes", 0},
+    {"alarm", 0},
+    {"relay_state", 0},
+    {"alarm_reason", 0},
+    {"off_reason", 0},
+    {"deepest_discharge_ampere_hours", 3},
+    {"last_discharge_ampere_hours", 3},
+    {"average_discharge_ampere_hours", 3},
+    {"charge_cycles", 0},
+    {"full_discharges", 0},
+    {"cumulative_ampere_hours_drawn", 3},
+    {"min_battery_voltage_volts", 3},
+    {"max_battery_voltage_volts", 3},
+    {"last_full_charge_seconds", 0},
+    {"automatic_synchronizations", 0},
+    {"low_main_voltage_alarms", 0},
+    {"high_main_voltage_alarms", 0},
+    {"low_auxiliary_voltage_alarms", 0},
+    {"high_auxiliary_voltage_alarms", 0},
+    {"min_auxiliary_voltage_volts", 3},
+    {"max_auxiliary_voltage_volts", 3},
+    {"discharged_energy_kilowatt_hours", 2},
+    {"charged_energy_kilowatt_hours", 2},
+    {"yield_total_kilowatt_hours", 2},
+    {"yield_today_kilowatt_hours", 2},
+    {"max_power_today_watts", 0},
+    {"yield_yesterday_kilowatt_hours", 2},
+    {"max_power_yesterday_watts", 0},
+    {"error_code", 0},
+    {"charging_mode", 0},
+    {nullptr, 0},
+    {nullptr, 0},
+    {nullptr, 0},
+    {nullptr, 0},
+    {nullptr, 0},
+    {"day_number", 0},
+    {"device_mode", 0},
+    {"ac_out_voltage_volts", 2},
+    {"ac_out_current_amperes", 1},
+    {"ac_out_apparent_power_voltamperes", 0},
+    {"warning_code", 0},
+    {"tracking_mode", 0},
+    {"monitor_mode", 0},
+};
+
+// Fixed point without going through float, e.g. 12345 with 3 decimals is "12.345"
+static void append_fixed(std::string &out, int32_t value, uint8_t decimals) {
+  static const uint32_t POWERS[] = {1, 10, 100, 1000};
+  char buffer[16];
+  const uint32_t magnitude = value < 0 ? 0u - (uint32_t) value : (uint32_t) value;
+  const uint32_t divisor = POWERS[decimals];
+  int length;
+  if (decimals == 0) {
+    length = snprintf(buffer, sizeof(buffer), "%s%" PRIu32, value < 0 ? "-" : "", magnitude);
+  } else {
+    length = snprintf(buffer, sizeof(buffer), "%s%" PRIu32 ".%0*" PRIu32, value < 0 ? "-" : "", magnitude / divisor,
+                      decimals, magnitude % divisor);
+  }
+  out.append(buffer, length);
+}
+
+static void append_label_value(std::string &out, const char *value) {
+  for (const char *c = value; *c != '\0'; c++) {
+    if (*c == '"' || *c == '\\')
+      out += '\\';
+    out += *c;
+  }
+}
+
+void VictronPrometheus::add_device(victron::VictronComponent *device, const std::string &name) {
+  this->devices_.push_back(Device{device, name});
+  device->add_on_frame_callback([this](const victron::Frame &frame) { this->dirty_ = true; });
+}
+
+void VictronPrometheus::setup() {
+  this->back_.reserve(1024 * this->devices_.size());
+  this->front_.reserve(1024 * this->devices_.size());
+  this->base_->init();
+  this->base_->add_handler(this);
+}
+
+void VictronPrometheus::dump_config() {
+  ESP_LOGCONFIG(TAG, "Victron Prometheus:");
+  ESP_LOGCONFIG(TAG, "  Path: %s", this->path_.c_str());
+  ESP_LOGCONFIG(TAG, "  Devices: %u", (unsigned) this->devices_.size());
+}
+
+// Rendering is done here instead of the frame callback, so the frames of several devices received in the same
+// iteration are rendered only once
+void VictronPrometheus::loop() {
+  if (!this->dirty_)
+    return;
+  this->dirty_ = false;
+
+  this->render_(this->back_);
+  LockGuard guard(this->lock_);
+  this->front_.swap(this->back_);
+}
+
+bool VictronPrometheus::canHandle(AsyncWebServerRequest *request) {
+  return request->method() == HTTP_GET && request->url() == this->path_.c_str();
+}
+
+void VictronPrometheus::handleRequest(AsyncWebServerRequest *request) {
+  // The only copy of the response, into the buffer of the stream
+  AsyncResponseStream *stream = request->beginResponseStream(CONTENT_TYPE);
+  {
+    LockGuard guard(this->lock_);
+    stream->print(this->front_.c_str());
+  }
+  request->send(stream);
+}
+
+void VictronPrometheus::render_(std::string &out) {
+  out.clear();
+
+  // Metrics of the same name are grouped, one sample per device
+  for (uint8_t index = 0; index < victron::FIELD_COUNT; index++) {
+    const auto field = static_cast<victron::FrameField>(index);
+    const Metric &metric = METRICS[index];
+    if (metric.name == nullptr)
+      continue;
+
+    bool header = false;
+    for (const auto &device : this->devices_) {
+      const victron::Frame &frame = device.device->get_frame();
+      if (!frame.has(field))
+        continue;
+      if (!header) {
+        out += "# TYPE victron_";
+        out += metric.name;
+        out += " gauge\n";
+        header = true;
+      }
+      out += "victron_";
+      out += metric.name;
+      out += "{device=\"";
+      out += device.name;
+      out += "\"} ";
+      append_fixed(out, frame.get(field), metric.decimals);
+      out += '\n';
+    }
+  }
+
+  this->render_info_(out);
+  this->render_counter_(out, "frames", &victron::LinkStats::frames);
+  this->render_counter_(out, "frames_repeated", &victron::LinkStats::frames_repeated);
+  this->render_counter_(out, "frames_dropped", &victron::LinkStats::frames_dropped);
+  this->render_counter_(out, "checksum_errors", &victron::LinkStats::checksum_errors);
+  this->render_counter_(out, "rx_timeouts", &victron::LinkStats::rx_timeouts);
+  out += "# EOF\n";
+}
+
+void VictronPrometheus::render_info_(std::string &out) {
+  out += "# TYPE victron_device info\n";
+  for (const auto &device : this->devices_) {
+    const victron::Frame &frame = device.device->get_frame();
+    out += "victron_device_info{device=\"";
+    out += device.name;
+    out += '"';
+    if (frame.has(victron::FIELD_PRODUCT_ID)) {
+      char product_id[12];
+      snprintf(product_id, sizeof(product_id), "0x%04" PRIX32, (uint32_t) frame.get(victron::FIELD_PRODUCT_ID));
+      out += ",product_id=\"";
+      out += product_id;
+      out += '"';
+    }
+    if (frame.has(victron::FIELD_SERIAL_NUMBER)) {
+      out += ",serial_number=\"";
+      append_label_value(out, frame.serial_number);
+      out += '"';
+    }
+    if (frame.has(victron::FIELD_FIRMWARE)) {
+      out += ",firmware=\"";
+      append_label_value(out, frame.firmware);
+      out += '"';
+    }
+    if (frame.has(victron::FIELD_MODEL_DESCRIPTION)) {
+      out += ",model=\"";
+      append_label_value(out, frame.model_description);
+      out += '"';
+    }
+    out += "} 1\n";
+  }
+}
+
+void VictronPrometheus::render_counter_(std::string &out, const char *name, uint32_t victron::LinkStats::*counter) {
+  out += "# TYPE victron_";
+  out += name;
+  out += " counter\n";
+  for (const auto &device : this->devices_) {
+    out += "victron_";
+    out += name;
+    out += "_total{device=\"";
+    out += device.name;
+    out += "\"} ";
+    char value[12];
+    out.append(value, snprintf(value, sizeof(value), "%" PRIu32 "\n", device.device->get_link_stats().*counter));
+  }
+}
+
+}  // namespace victron_prometheus
+}  // namespace esphome
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/victron/victron.h"
+#include "esphome/components/web_server_base/web_server_base.h"
+
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace victron_prometheus {
+
+/// Serves the values and link counters of victron devices in the OpenMetrics text format.
+///
+/// The response is rendered once per committed frame and shared by all scrapes. Every request streams the last
+/// rendered response, the next one is rendered into a second buffer and swapped in.
+class VictronPrometheus : public AsyncWebHandler, public Component {
+ public:
+  explicit VictronPrometheus(web_server_base::WebServerBase *base) : base_(base) {}
+
+  void set_path(const std::string &path) { this->path_ = path; }
+  void add_device(victron::VictronComponent *device, const std::string &name);
+
+  bool canHandle(AsyncWebServerRequest *request) override;
+  void handleRequest(AsyncWebServerRequest *request) override;
+
+  void setup() override;
+  void dump_config() override;
+  void loop() override;
+
+  float get_setup_priority() const override { return setup_priority::WIFI - 1.0f; }
+
+ protected:
+  struct Device {
+    victron::VictronComponent *device;
+    std::string name;
+  };
+
+  void render_(std::string &out);
+  void render_info_(std::string &out);
+  void render_counter_(std::string &out, const char *name, uint32_t victron::LinkStats::*counter);
+
+  web_server_base::WebServerBase *base_;
+  std::string path_;
+  std::vector<Device> devices_;
+  // Only used by loop()
+  std::string back_;
+  // Streamed by handleRequest(), which runs in the context of the web server
+  std::string front_;
+  Mutex lock_;
+  // A device committed a frame since the last rendering
+  bool dirty_{true};
+};
+
+}  // namespace victron_prometheus
+}  // namespace esphome
@@ -0,0 +1,56 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+from esphome.components.victron import CONF_VICTRON_ID, VictronComponent, victron_ns
+
+DEPENDENCIES = ["victron"]
+
+MULTI_CONF = True
+
+victron_statistics_ns = cg.esphome_ns.namespace("victron_statistics")
+VictronStatistics = victron_statistics_ns.class_("VictronStatistics", cg.Component)
+FrameField = victron_ns.enum("FrameField")
+
+CONF_VICTRON_STATISTICS_ID = "victron_statistics_id"
+CONF_FIELD = "field"
+CONF_WINDOW = "window"
+
+# Field and factor from the native unit of the protocol to the unit of the sensors
+FIELDS = {
+    "battery_voltage": (FrameField.FIELD_BATTERY_VOLTAGE, 0.001),
+    "battery_current": (FrameField.FIELD_BATTERY_CURRENT, 0.001),
+    "panel_voltage": (FrameField.FIELD_PANEL_VOLTAGE, 0.001),
+    "panel_power": (FrameField.FIELD_PANEL_POWER, 1.0),
+    "load_current": (FrameField.FIELD_LOAD_CURRENT, 0.001),
+    "instantaneous_power": (FrameField.FIELD_INSTANTANEOUS_POWER, 1.0),
+    "state_of_charge": (FrameField.FIELD_STATE_OF_CHARGE, 0.1),
+    "battery_temperature": (FrameField.FIELD_BATTERY_TEMPERATURE, 1.0),
+    "ac_out_voltage": (FrameField.FIELD_AC_OUT_VOLTAGE, 0.01),
+    "ac_out_current": (FrameField.FIELD_AC_OUT_CURRENT, 0.1),
+    "ac_out_apparent_power": (FrameField.FIELD_AC_OUT_APPARENT_POWER, 1.0),
+}
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(VictronStatistics),
+        cv.GenerateID(CONF_VICTRON_ID): cv.use_id(VictronComponent),
+        cv.Required(CONF_FIELD): cv.one_of(*FIELDS, lower=True),
+        cv.Optional(CONF_WINDOW, default="1h"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(min=cv.TimePeriod(seconds=10)),
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    victron = yield cg.get_variable(config[CONF_VICTRON_ID])
+    cg.add(var.set_victron(victron))
+    field, scale = FIELDS[config[CONF_FIELD]]
+    cg.add(var.set_field(field))
+    cg.add(var.set_scale(scale))
+    cg.add(var.set_window(config[CONF_WINDOW]))
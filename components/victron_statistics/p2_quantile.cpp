@@ -0,0 +1,91 @@
+#include "p2_quantile.h"
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace victron_statistics {
+
+void P2Quantile::add(float sample) {
+  const float p = this->quantile_;
+  float *h = this->heights_;
+  int32_t *n = this->positions_;
+
+  // The first samples are the initial markers
+  if (this->count_ < 5) {
+    h[this->count_++] = sample;
+    if (this->count_ == 5) {
+      std::sort(h, h + 5);
+      for (int i = 0; i < 5; i++)
+        n[i] = i + 1;
+      this->desired_[0] = 1.0f;
+      this->desired_[1] = 1.0f + 2.0f * p;
+      this->desired_[2] = 1.0f + 4.0f * p;
+      this->desired_[3] = 3.0f + 2.0f * p;
+      this->desired_[4] = 5.0f;
+    }
+    return;
+  }
+  this->count_++;
+
+  // Cell of the sample, extending the range if necessary
+  int cell;
+  if (sample < h[0]) {
+    h[0] = sample;
+    cell = 0;
+  } else if (sample >= h[4]) {
+    h[4] = sample;
+    cell = 3;
+  } else {
+    cell = 0;
+    while (sample >= h[cell + 1])
+      cell++;
+  }
+
+  for (int i = cell + 1; i < 5; i++)
+    n[i]++;
+  const float increments[5] = {0.0f, p / 2.0f, p, (1.0f + p) / 2.0f, 1.0f};
+  for (int i = 0; i < 5; i++)
+    this->desired_[i] += increments[i];
+
+  // Move the middle markers towards their desired positions
+  for (int i = 1; i < 4; i++) {
+    const float offset = this->desired_[i] - n[i];
+    if ((offset >= 1.0f && n[i + 1] - n[i] > 1) || (offset <= -1.0f && n[i - 1] - n[i] < -1)) {
+      const int direction = offset >= 0.0f ? 1 : -1;
+      const float height = this->parabolic_(i, direction);
+      h[i] = (h[i - 1] < height && height < h[i + 1]) ? height : this->linear_(i, direction);
+      n[i] += direction;
+    }
+  }
+}
+
+float P2Quantile::value() const {
+  if (this->count_ == 0)
+    return NAN;
+  if (this->count_ >= 5)
+    return this->heights_[2];
+
+  // Exact quantile of the few samples received so far
+  float sorted[5];
+  std::copy(this->heights_, this->heights_ + this->count_, sorted);
+  std::sort(sorted, sorted + this->count_);
+  return sorted[(uint32_t) lroundf(this->quantile_ * (this->count_ - 1))];
+}
+
+float P2Quantile::parabolic_(int i, int direction) const {
+  const float *h = this->heights_;
+  const int32_t *n = this->positions_;
+  const float d = direction;
+  return h[i] + d / (n[i + 1] - n[i - 1]) *
+                    ((n[i] - n[i - 1] + d) * (h[i + 1] - h[i]) / (n[i + 1] - n[i]) +
+                     (n[i + 1] - n[i] - d) * (h[i] - h[i - 1]) / (n[i] - n[i - 1]));
+}
+
+float P2Quantile::linear_(int i, int direction) const {
+  const float *h = this->heights_;
+  const int32_t *n = this->positions_;
+  return h[i] + direction * (h[i + direction] - h[i]) / (n[i + direction] - n[i]);
+}
+
+}  // namespace victron_statistics
+}  // namespace esphome
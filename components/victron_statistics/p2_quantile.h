@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace victron_statistics {
+
+/// Streaming estimate of a quantile in constant time and memory (P² algorithm of Jain and Chlamtac).
+///
+/// Five markers track the minimum, the quantile, the maximum and two points in between. Their heights are
+/// adjusted with a piecewise-parabolic interpolation on every sample.
+class P2Quantile {
+ public:
+  explicit P2Quantile(float quantile) : quantile_(quantile) {}
+
+  void add(float sample);
+  /// NAN if there is no sample yet.
+  float value() const;
+  void reset() { this->count_ = 0; }
+
+ protected:
+  float parabolic_(int i, int direction) const;
+  float linear_(int i, int direction) const;
+
+  float quantile_;
+  float heights_[5];
+  int32_t positions_[5];
+  float desired_[5];
+  uint32_t count_{0};
+};
+
+}  // namespace victron_statistics
+}  // namespace esphome
@@ -0,0 +1,69 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_MAX,
+    CONF_MIN,
+    ICON_COUNTER,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_EMPTY,
+)
+
+from . import CONF_VICTRON_STATISTICS_ID, VictronStatistics
+
+DEPENDENCIES = ["victron_statistics"]
+
+CODEOWNERS = ["@KinDR007"]
+
+CONF_MEAN = "mean"
+CONF_SAMPLES = "samples"
+CONF_QUANTILES = "quantiles"
+CONF_QUANTILE = "quantile"
+
+SENSORS = [
+    CONF_MIN,
+    CONF_MAX,
+    CONF_MEAN,
+    CONF_SAMPLES,
+]
+
+# The unit depends on the field and is up to the user
+STATISTIC_SCHEMA = sensor.sensor_schema(
+    accuracy_decimals=2,
+    state_class=STATE_CLASS_MEASUREMENT,
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_VICTRON_STATISTICS_ID): cv.use_id(VictronStatistics),
+        cv.Optional(CONF_MIN): STATISTIC_SCHEMA,
+        cv.Optional(CONF_MAX): STATISTIC_SCHEMA,
+        cv.Optional(CONF_MEAN): STATISTIC_SCHEMA,
+        cv.Optional(CONF_SAMPLES): sensor.sensor_schema(
+            unit_of_measurement=UNIT_EMPTY,
+            icon=ICON_COUNTER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ),
+        cv.Optional(CONF_QUANTILES): cv.ensure_list(
+            STATISTIC_SCHEMA.extend(
+                {
+                    cv.Required(CONF_QUANTILE): cv.float_range(
+                        min=0.0, max=1.0, min_included=False, max_included=False
+                    ),
+                }
+            )
+        ),
+    }
+)
+
+
+def to_code(config):
+    hub = yield cg.get_variable(config[CONF_VICTRON_STATISTICS_ID])
+    for key in SENSORS:
+        if key in config:
+            sens = yield sensor.new_sensor(config[key])
+            cg.add(getattr(hub, f"set_{key}_sensor")(sens))
+    for conf in config.get(CONF_QUANTILES, []):
+        sens = yield sensor.new_sensor(conf)
+        cg.add(hub.add_quantile_sensor(conf[CONF_QUANTILE], sens))
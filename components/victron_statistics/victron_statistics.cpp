@@ -0,0 +1,79 @@
+#include "victron_statistics.h"
+#include "esphome/core/log.h"
+#include <cinttypes>
+
+namespace esphome {
+namespace victron_statistics {
+
+static const char *const TAG = "victron_statistics";
+
+void VictronStatistics::set_victron(victron::VictronComponent *victron) {
+  victron->add_on_frame_callback([this](const victron::Frame &frame) { this->add_sample_(frame); });
+}
+
+void VictronStatistics::add_quantile_sensor(float quantile, sensor::Sensor *sensor) {
+  this->quantiles_.push_back(Quantile{P2Quantile(quantile), sensor});
+}
+
+void VictronStatistics::setup() { this->window_start_ = millis(); }
+
+void VictronStatistics::dump_config() {
+  ESP_LOGCONFIG(TAG, "Victron Statistics:");
+  ESP_LOGCONFIG(TAG, "  Field: %u", this->field_);
+  ESP_LOGCONFIG(TAG, "  Window: %" PRIu32 " ms", this->window_);
+  LOG_SENSOR("  ", "Min", this->min_sensor_);
+  LOG_SENSOR("  ", "Max", this->max_sensor_);
+  LOG_SENSOR("  ", "Mean", this->mean_sensor_);
+  LOG_SENSOR("  ", "Samples", this->samples_sensor_);
+  for (const auto &quantile : this->quantiles_)
+    LOG_SENSOR("  ", "Quantile", quantile.sensor);
+}
+
+// Called for every committed frame
+void VictronStatistics::add_sample_(const victron::Frame &frame) {
+  // Values persist across blocks, only the block containing the field is a new sample
+  if (!(frame.received & victron::field_bit(this->field_)) || !frame.has(this->field_))
+    return;
+
+  const int32_t value = frame.get(this->field_);
+  if (this->count_ == 0 || value < this->min_)
+    this->min_ = value;
+  if (this->count_ == 0 || value > this->max_)
+    this->max_ = value;
+  this->sum_ += value;
+  this->count_++;
+  for (auto &quantile : this->quantiles_)
+    quantile.estimator.add(value);
+}
+
+void VictronStatistics::loop() {
+  const uint32_t now = millis();
+  if (now - this->window_start_ < this->window_)
+    return;
+  // Keep the windows aligned to the first one
+  this->window_start_ += this->window_;
+  this->publish_window_();
+}
+
+void VictronStatistics::publish_window_() {
+  // A window without samples (link down) is published as NAN
+  const bool empty = this->count_ == 0;
+  if (this->min_sensor_ != nullptr)
+    this->min_sensor_->publish_state(empty ? NAN : this->min_ * this->scale_);
+  if (this->max_sensor_ != nullptr)
+    this->max_sensor_->publish_state(empty ? NAN : this->max_ * this->scale_);
+  if (this->mean_sensor_ != nullptr)
+    this->mean_sensor_->publish_state(empty ? NAN : (float) this->sum_ / this->count_ * this->scale_);
+  if (this->samples_sensor_ != nullptr)
+    this->samples_sensor_->publish_state(this->count_);
+  for (auto &quantile : this->quantiles_) {
+    quantile.sensor->publish_state(quantile.estimator.value() * this->scale_);
+    quantile.estimator.reset();
+  }
+
+  this->sum_ = 0;
+  this->count_ = 0;
+}
+
+}  // namespace victron_statistics
+}  // namespace esphome
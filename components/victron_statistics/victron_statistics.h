@@ -0,0 +1,65 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/victron/victron.h"
+#include "p2_quantile.h"
+
+#include <vector>
+
+namespace esphome {
+namespace victron_statistics {
+
+/// Summarizes one field of a victron device over a time window: minimum, maximum, mean and quantiles.
+///
+/// Every frame is a sample. Time and memory per sample are constant, the summary is published at the end of
+/// each window.
+class VictronStatistics : public Component {
+ public:
+  void set_victron(victron::VictronComponent *victron);
+  void set_field(victron::FrameField field) { this->field_ = field; }
+  /// Factor from the native unit of the field to the unit of the sensors.
+  void set_scale(float scale) { this->scale_ = scale; }
+  void set_window(uint32_t window) { this->window_ = window; }
+
+  void set_min_sensor(sensor::Sensor *min_sensor) { min_sensor_ = min_sensor; }
+  void set_max_sensor(sensor::Sensor *max_sensor) { max_sensor_ = max_sensor; }
+  void set_mean_sensor(sensor::Sensor *mean_sensor) { mean_sensor_ = mean_sensor; }
+  void set_samples_sensor(sensor::Sensor *samples_sensor) { samples_sensor_ = samples_sensor; }
+  void add_quantile_sensor(float quantile, sensor::Sensor *sensor);
+
+  void setup() override;
+  void dump_config() override;
+  void loop() override;
+
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+ protected:
+  struct Quantile {
+    P2Quantile estimator;
+    sensor::Sensor *sensor;
+  };
+
+  void add_sample_(const victron::Frame &frame);
+  void publish_window_();
+
+  victron::FrameField field_{victron::FIELD_BATTERY_VOLTAGE};
+  float scale_{1.0f};
+  uint32_t window_{0};
+  uint32_t window_start_{0};
+
+  // Native integer units, so the sum of a long window doesn't lose precision
+  int64_t sum_{0};
+  uint32_t count_{0};
+  int32_t min_{0};
+  int32_t max_{0};
+  std::vector<Quantile> quantiles_;
+
+  sensor::Sensor *min_sensor_{nullptr};
+  sensor::Sensor *max_sensor_{nullptr};
+  sensor::Sensor *mean_sensor_{nullptr};
+  sensor::Sensor *samples_sensor_{nullptr};
+};
+
+}  // namespace victron_statistics
+}  // namespace esphome
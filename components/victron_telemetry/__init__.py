@@ -0,0 +1,41 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ADDRESS, CONF_ID, CONF_PORT
+
+from esphome.components.victron import CONF_VICTRON_ID, VictronComponent
+
+AUTO_LOAD = ["socket"]
+
+DEPENDENCIES = ["victron", "network"]
+
+MULTI_CONF = True
+
+victron_telemetry_ns = cg.esphome_ns.namespace("victron_telemetry")
+VictronTelemetry = victron_telemetry_ns.class_("VictronTelemetry", cg.Component)
+
+CONF_DEVICE_ID = "device_id"
+CONF_KEYFRAME_INTERVAL = "keyframe_interval"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(VictronTelemetry),
+        cv.GenerateID(CONF_VICTRON_ID): cv.use_id(VictronComponent),
+        # Unicast or multicast
+        cv.Required(CONF_ADDRESS): cv.ipv4,
+        cv.Optional(CONF_PORT, default=5680): cv.port,
+        cv.Required(CONF_DEVICE_ID): cv.uint32_t,
+        # 1 = keyframes only
+        cv.Optional(CONF_KEYFRAME_INTERVAL, default=60): cv.int_range(min=1, max=65535),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    victron = yield cg.get_variable(config[CONF_VICTRON_ID])
+    cg.add(var.set_victron(victron))
+    cg.add(var.set_collector(str(config[CONF_ADDRESS]), config[CONF_PORT]))
+    cg.add(var.set_device_id(config[CONF_DEVICE_ID]))
+    cg.add(var.set_keyframe_interval(config[CONF_KEYFRAME_INTERVAL]))
@@ -0,0 +1,120 @@
+#include "victron_telemetry.h"
+#include "esphome/core/log.h"
+#include "esphome/components/network/util.h"
+#include <cinttypes>
+
+namespace esphome {
+namespace victron_telemetry {
+
+static const char *const TAG = "victron_telemetry";
+
+static const uint64_t TEXT_FIELDS =
+    victron::field_bit(victron::FIELD_MODEL_DESCRIPTION) | victron::field_bit(victron::FIELD_FIRMWARE) |
+    victron::field_bit(victron::FIELD_FIRMWARE_24BIT) | victron::field_bit(victron::FIELD_SERIAL_NUMBER);
+
+static uint8_t *put_u32(uint8_t *pos, uint32_t value) {
+  for (uint8_t i = 0; i < 4; i++)
+    *pos++ = value >> (8 * i);
+  return pos;
+}
+
+static uint8_t *put_u64(uint8_t *pos, uint64_t value) {
+  for (uint8_t i = 0; i < 8; i++)
+    *pos++ = value >> (8 * i);
+  return pos;
+}
+
+void VictronTelemetry::set_victron(victron::VictronComponent *victron) {
+  victron->add_on_frame_callback([this](const victron::Frame &frame) { this->send_(frame); });
+}
+
+void VictronTelemetry::setup() {
+#if defined(USE_SOCKET_IMPL_BSD_SOCKETS) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS)
+  this->socket_ = socket::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (this->socket_ == nullptr) {
+    ESP_LOGE(TAG, "Could not create socket");
+    this->mark_failed();
+    return;
+  }
+  this->destination_length_ = socket::set_sockaddr(reinterpret_cast<struct sockaddr *>(&this->destination_),
+                                                   sizeof(this->destination_), this->address_, this->port_);
+  if (this->destination_length_ == 0) {
+    ESP_LOGE(TAG, "Invalid collector address %s", this->address_.c_str());
+    this->mark_failed();
+  }
+#else
+  if (!this->destination_.fromString(this->address_.c_str())) {
+    ESP_LOGE(TAG, "Invalid collector address %s", this->address_.c_str());
+    this->mark_failed();
+  }
+#endif
+}
+
+void VictronTelemetry::dump_config() {
+  ESP_LOGCONFIG(TAG, "Victron Telemetry:");
+  ESP_LOGCONFIG(TAG, "  Collector: %s:%u", this->address_.c_str(), this->port_);
+  ESP_LOGCONFIG(TAG, "  Device ID: %" PRIu32, this->device_id_);
+  ESP_LOGCONFIG(TAG, "  Keyframe interval: %u", this->keyframe_interval_);
+}
+
+size_t VictronTelemetry::encode_(const victron::Frame &frame, uint8_t *record) {
+  const uint64_t valid = frame.valid & ~TEXT_FIELDS;
+
+  const bool keyframe = this->sequence_ == 0 || ++this->deltas_ >= this->keyframe_interval_;
+  uint64_t present;
+  if (keyframe) {
+    present = valid;
+    this->deltas_ = 0;
+  } else {
+    // Fields which appeared or disappeared, and the ones whose value changed
+    present = valid ^ this->sent_valid_;
+    for (uint64_t both = valid & this->sent_valid_; both != 0; both &= both - 1) {
+      const uint8_t index = __builtin_ctzll(both);
+      if (frame.values[index] != this->sent_values_[index])
+        present |= uint64_t(1) << index;
+    }
+  }
+
+  uint8_t *pos = record;
+  *pos++ = 'V';
+  *pos++ = 'D';
+  *pos++ = RECORD_VERSION;
+  *pos++ = keyframe ? 0 : FLAG_DELTA;
+  pos = put_u32(pos, this->device_id_);
+  pos = put_u32(pos, this->sequence_++);
+  pos = put_u64(pos, present);
+  for (; present != 0; present &= present - 1) {
+    const uint8_t index = __builtin_ctzll(present);
+    const bool available = valid & (uint64_t(1) << index);
+    const int32_t value = available ? frame.values[index] : VALUE_NOT_AVAILABLE;
+    pos = put_u32(pos, value);
+    this->sent_values_[index] = value;
+  }
+  this->sent_valid_ = valid;
+  return pos - record;
+}
+
+// Called for every committed frame
+void VictronTelemetry::send_(const victron::Frame &frame) {
+  if (this->is_failed() || !network::is_connected())
+    return;
+
+  uint8_t record[MAX_RECORD_SIZE];
+  const size_t length = this->encode_(frame, record);
+
+#if defined(USE_SOCKET_IMPL_BSD_SOCKETS) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS)
+  const bool sent = this->socket_->sendto(record, length, 0, reinterpret_cast<struct sockaddr *>(&this->destination_),
+                                          this->destination_length_) == (ssize_t) length;
+#else
+  const bool sent = this->udp_.beginPacket(this->destination_, this->port_) &&
+                    this->udp_.write(record, length) == length && this->udp_.endPacket();
+#endif
+  if (!sent) {
+    // The collector notices the gap in the sequence numbers and waits for the next keyframe
+    this->send_errors_++;
+    ESP_LOGD(TAG, "Sending record %" PRIu32 " failed, %" PRIu32 " error(s)", this->sequence_ - 1, this->send_errors_);
+  }
+}
+
+}  // namespace victron_telemetry
+}  // namespace esphome
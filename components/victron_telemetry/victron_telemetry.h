@@ -0,0 +1,82 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/components/victron/victron.h"
+
+#if defined(USE_SOCKET_IMPL_BSD_SOCKETS) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS)
+#include "esphome/components/socket/socket.h"
+#else
+#include <WiFiUdp.h>
+#endif
+
+#include <string>
+
+namespace esphome {
+namespace victron_telemetry {
+
+// Layout of a record, all integers little endian:
+//
+//   0  2  magic "VD"
+//   2  1  version
+//   3  1  flags (FLAG_DELTA)
+//   4  4  device id
+//   8  4  sequence number, +1 per record
+//  12  8  bitmap of the fields (bit = FrameField) whose values follow
+//  20  4n values of the fields in the order of the bitmap, native integer units of the protocol
+//
+// A keyframe carries all valid fields. A delta record only carries the fields which changed since the record
+// before, a field which isn't available anymore has the value VALUE_NOT_AVAILABLE. Text fields (BMV, FW, FWE,
+// SER#) aren't sent.
+static const uint8_t RECORD_VERSION = 1;
+static const uint8_t FLAG_DELTA = 0x01;
+static const size_t RECORD_HEADER_SIZE = 20;
+static const size_t MAX_RECORD_SIZE = RECORD_HEADER_SIZE + 4 * victron::FIELD_COUNT;
+static const int32_t VALUE_NOT_AVAILABLE = INT32_MIN;
+
+/// Sends every frame of a victron device as a compact binary record by UDP (unicast or multicast).
+class VictronTelemetry : public Component {
+ public:
+  void set_victron(victron::VictronComponent *victron);
+  void set_collector(const std::string &address, uint16_t port) {
+    this->address_ = address;
+    this->port_ = port;
+  }
+  void set_device_id(uint32_t device_id) { this->device_id_ = device_id; }
+  /// Send a keyframe every `keyframe_interval` records and delta records in between, 1 = keyframes only.
+  void set_keyframe_interval(uint16_t keyframe_interval) { this->keyframe_interval_ = keyframe_interval; }
+
+  void setup() override;
+  void dump_config() override;
+
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+ protected:
+  size_t encode_(const victron::Frame &frame, uint8_t *record);
+  void send_(const victron::Frame &frame);
+
+  std::string address_;
+  uint16_t port_{0};
+  uint32_t device_id_{0};
+  uint16_t keyframe_interval_{0};
+  // Records since the last keyframe
+  uint16_t deltas_{0};
+  uint32_t sequence_{0};
+  uint32_t send_errors_{0};
+
+  // State of the collector after the last record
+  int32_t sent_values_[victron::FIELD_COUNT]{};
+  uint64_t sent_valid_{0};
+
+#if defined(USE_SOCKET_IMPL_BSD_SOCKETS) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS)
+  std::unique_ptr<socket::Socket> socket_;
+  struct sockaddr_storage destination_ {};
+  socklen_t destination_length_{0};
+#else
+  WiFiUDP udp_;
+  IPAddress destination_;
+#endif
+};
+
+}  // namespace victron_telemetry
+}  // namespace esphome
@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+"""VE.Direct text protocol emulator.
+
+Creates one pseudo terminal per virtual device and writes realistic MPPT, BMV or
+Phoenix inverter frames to it. Point a `host_uart` of an ESPHome host build at
+the printed device (or at the stable symlink) to load test the victron component.
+"""
+
+import argparse
+import math
+import os
+import pty
+import random
+import select
+import sys
+import time
+import tty
+
+
+def checksum(data):
+    return (256 - sum(data) % 256) % 256
+
+
+def block(fields):
+    data = b"".join(b"\r\n%s\t%s" % (k.encode(), v.encode()) for k, v in fields)
+    data += b"\r\nChecksum\t"
+    return data + bytes([checksum(data)])
+
+
+def hex_message(register, value):
+    # Asynchronous HEX message: ':' command register flags value checksum '\n'
+    payload = bytes([0x0A, register & 0xFF, register >> 8, 0x00]) + value.to_bytes(
+        2, "little"
+    )
+    check = (0x55 - sum(payload)) & 0xFF
+    text = "A" + (payload[1:] + bytes([check])).hex().upper()
+    return b":" + text.encode() + b"\n"
+
+
+class Device:
+    def __init__(self, index, serial):
+        self.index = index
+        self.serial = serial
+        self.yield_today = 0.0
+
+    def sun(self, now):
+        # Fake diurnal curve with a period of ten minutes so a test run covers day and night
+        return max(0.0, math.sin(2 * math.pi * (now / 600.0 + self.index / 7.0)))
+
+    def frames(self, now):
+        raise NotImplementedError
+
+
+class Mppt(Device):
+    def frames(self, now):
+        sun = self.sun(now)
+        ppv = int(sun * 400 + random.uniform(0, 3)) if sun > 0 else 0
+        voltage = 12600 + int(sun * 1500) + random.randint(-20, 20)
+        current = int(ppv * 1e6 / voltage * 0.97) if ppv else 0
+        self.yield_today = 0.0 if sun == 0 else self.yield_today + ppv / 3600.0
+        state = 0 if ppv == 0 else (3 if voltage < 13800 else 5)
+        return [
+            block(
+                [
+                    ("PID", "0xA053"),
+                    ("FW", "159"),
+                    ("SER#", self.serial),
+                    ("V", str(voltage)),
+                    ("I", str(current)),
+                    ("VPV", str(17000 + int(sun * 2500)) if ppv else "10"),
+                    ("PPV", str(ppv)),
+                    ("CS", str(state)),
+                    ("MPPT", "2" if ppv else "0"),
+                    ("OR", "0x00000000" if ppv else "0x00000001"),
+                    ("ERR", "0"),
+                    ("LOAD", "ON"),
+                    ("IL", str(300 + random.randint(0, 10))),
+                    ("H19", "12345"),
+                    ("H20", str(int(self.yield_today / 10))),
+                    ("H21", "412"),
+                    ("H22", "231"),
+                    ("H23", "398"),
+                    ("HSDS", "123"),
+                ]
+            )
+        ]
+
+
+class Bmv(Device):
+    def frames(self, now):
+        sun = self.sun(now)
+        current = int((sun * 20 - 4) * 1000) + random.randint(-50, 50)
+        voltage = 12700 + current // 100
+        soc = max(0, min(1000, 800 + current // 100))
+        return [
+            block(
+                [
+                    ("PID", "0x203"),
+                    ("V", str(voltage)),
+                    ("VS", "12550"),
+                    ("I", str(current)),
+                    ("P", str(voltage * current // 1000000)),
+                    ("CE", "-12500"),
+                    ("SOC", str(soc)),
+                    ("TTG", "-1" if current >= 0 else "600"),
+                    ("Alarm", "OFF"),
+                    ("Relay", "OFF"),
+                    ("AR", "0"),
+                    ("BMV", "700"),
+                    ("FW", "0308"),
+                ]
+            ),
+            block([("H%d" % i, str(i * 100)) for i in range(1, 19)]),
+        ]
+
+
+class Phoenix(Device):
+    def frames(self, now):
+        current = 200 + random.randint(0, 20)
+        return [
+            block(
+                [
+                    ("PID", "0xA231"),
+                    ("FW", "0114"),
+                    ("SER#", self.serial),
+                    ("MODE", "2"),
+                    ("CS", "9"),
+                    ("AC_OUT_V", str(23000 + random.randint(-30, 30))),
+                    ("AC_OUT_I", str(current // 10)),
+                    ("AC_OUT_S", str(230 * current // 100)),
+                    ("V", "12800"),
+                    ("AR", "0"),
+                    ("WARN", "0"),
+                    ("OR", "0x00000000"),
+                ]
+            )
+        ]
+
+
+DEVICE_TYPES = {"mppt": Mppt, "bmv": Bmv, "phoenix": Phoenix}
+
+
+def corrupt(data):
+    data = bytearray(data)
+    pos = random.randrange(len(data))
+    data[pos] ^= 1 << random.randrange(8)
+    return bytes(data)
+
+
+def inject_hex(data):
+    # Async HEX messages are sent between two lines
+    lines = [i for i in range(len(data) - 1) if data[i : i + 2] == b"\r\n"]
+    pos = random.choice(lines)
+    return data[:pos] + hex_message(0x0201, random.randint(0, 9)) + data[pos:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--devices", type=int, default=1, help="number of virtual devices")
+    parser.add_argument(
+        "--type",
+        default="mppt",
+        help="comma separated device types (mppt, bmv, phoenix) assigned round robin",
+    )
+    parser.add_argument("--rate", type=float, default=1.0, help="frames per second and device")
+    parser.add_argument(
+        "--corruption-rate", type=float, default=0.0, help="probability of a bit error per frame"
+    )
+    parser.add_argument(
+        "--hex-rate", type=float, default=0.0, help="probability of an async HEX message per frame"
+    )
+    parser.add_argument(
+        "--link", default="/tmp/vedirect", help="create stable symlinks <link>0, <link>1, ..."
+    )
+    parser.add_argument("--seed", type=int, help="random seed")
+    args = parser.parse_args()
+
+    random.seed(args.seed)
+    types = [t.strip() for t in args.type.split(",")]
+    for t in types:
+        if t not in DEVICE_TYPES:
+            parser.error("unknown device type %s" % t)
+
+    devices = []
+    for i in range(args.devices):
+        master, slave = pty.openpty()
+        tty.setraw(slave)
+        os.set_blocking(master, False)
+        name = os.ttyname(slave)
+        if args.link:
+            link = "%s%d" % (args.link, i)
+            if os.path.islink(link):
+                os.unlink(link)
+            os.symlink(name, link)
+            name = "%s -> %s" % (link, name)
+        device = DEVICE_TYPES[types[i % len(types)]](i, "HQ%09d" % (2200000 + i))
+        # Keep the slave open, otherwise the pty goes away between two clients
+        device.fds = (master, slave)
+        device.due = time.monotonic() + random.random() / args.rate
+        device.stats = {"frames": 0, "bytes": 0, "dropped": 0}
+        devices.append(device)
+        print("%s %d: %s" % (type(device).__name__, i, name))
+    sys.stdout.flush()
+
+    interval = 1.0 / args.rate
+    report = time.monotonic() + 10
+    try:
+        while True:
+            now = time.monotonic()
+            for device in devices:
+                if device.due > now:
+                    continue
+                device.due += interval
+                for data in device.frames(time.time()):
+                    if random.random() < args.hex_rate:
+                        data = inject_hex(data)
+                    if random.random() < args.corruption_rate:
+                        data = corrupt(data)
+                    try:
+                        os.write(device.fds[0], data)
+                        device.stats["frames"] += 1
+                        device.stats["bytes"] += len(data)
+                    except BlockingIOError:
+                        # Nobody reads the pty: the buffer of the line discipline is full
+                        device.stats["dropped"] += 1
+                # Discard anything written to the device (HEX commands)
+                while select.select([device.fds[0]], [], [], 0)[0]:
+                    if not os.read(device.fds[0], 1024):
+                        break
+            if now >= report:
+                report += 10
+                frames = sum(d.stats["frames"] for d in devices)
+                sent = sum(d.stats["bytes"] for d in devices)
+                dropped = sum(d.stats["dropped"] for d in devices)
+                print("%d frames, %d bytes sent, %d frames dropped" % (frames, sent, dropped))
+                sys.stdout.flush()
+            time.sleep(max(0.0, min(d.due for d in devices) - time.monotonic()))
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Reference decoder of the records sent by the victron_telemetry component.
+
+Listens for UDP records (unicast or multicast), applies the delta records to the
+last keyframe of every device and prints one JSON object per record with the
+values in the native integer units of the VE.Direct protocol.
+"""
+
+import argparse
+import json
+import socket
+import struct
+import sys
+
+MAGIC = b"VD"
+VERSION = 1
+FLAG_DELTA = 0x01
+HEADER = struct.Struct("<2sBBIIQ")
+VALUE_NOT_AVAILABLE = -(2**31)
+
+# Labels in the order of FrameField (components/victron/frame.h)
+LABELS = [
+    "V", "V2", "V3", "VS", "VM", "DM", "VPV", "PPV",
+    "I", "I2", "I3", "IL", "LOAD", "T", "P", "CE",
+    "SOC", "TTG", "Alarm", "RELAY", "AR", "OR", "H1", "H2",
+    "H3", "H4", "H5", "H6", "H7", "H8", "H9", "H10",
+    "H11", "H12", "H13", "H14", "H15", "H16", "H17", "H18",
+    "H19", "H20", "H21", "H22", "H23", "ERR", "CS", "BMV",
+    "FW", "FWE", "PID", "SER#", "HSDS", "MODE", "AC_OUT_V", "AC_OUT_I",
+    "AC_OUT_S", "WARN", "MPPT", "MON",
+]  # fmt: skip
+
+
+class DecodeError(Exception):
+    pass
+
+
+def decode(record):
+    """Split a record into (device_id, sequence, delta, {label: value})."""
+    if len(record) < HEADER.size:
+        raise DecodeError("record too short")
+    magic, version, flags, device_id, sequence, present = HEADER.unpack_from(record)
+    if magic != MAGIC:
+        raise DecodeError("bad magic")
+    if version != VERSION:
+        raise DecodeError("unsupported version %d" % version)
+    indices = [i for i in range(64) if present & (1 << i)]
+    if len(record) != HEADER.size + 4 * len(indices):
+        raise DecodeError("length doesn't match the bitmap")
+    if indices and indices[-1] >= len(LABELS):
+        raise DecodeError("unknown field %d" % indices[-1])
+    values = struct.unpack_from("<%di" % len(indices), record, HEADER.size)
+    fields = {LABELS[i]: v for i, v in zip(indices, values)}
+    return device_id, sequence, bool(flags & FLAG_DELTA), fields
+
+
+class Collector:
+    """Values of every device, rebuilt from keyframes and delta records."""
+
+    def __init__(self):
+        self.devices = {}
+
+    def apply(self, record):
+        device_id, sequence, delta, fields = decode(record)
+        device = self.devices.get(device_id)
+        if delta:
+            # A lost record invalidates the state until the next keyframe
+            if device is None or device["sequence"] + 1 != sequence:
+                if device is not None:
+                    device["synced"] = False
+                return None
+            if not device["synced"]:
+                return None
+            values = device["values"]
+        else:
+            values = {}
+            device = self.devices[device_id] = {"values": values, "synced": True}
+        device["sequence"] = sequence
+        for label, value in fields.items():
+            if value == VALUE_NOT_AVAILABLE:
+                values.pop(label, None)
+            else:
+                values[label] = value
+        return {"device_id": device_id, "sequence": sequence, "values": dict(values)}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", type=int, default=5680, help="UDP port")
+    parser.add_argument("--group", help="join this multicast group")
+    parser.add_argument("--raw", action="store_true", help="print records without applying deltas")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(("", args.port))
+    if args.group:
+        membership = struct.pack("4s4s", socket.inet_aton(args.group), socket.inet_aton("0.0.0.0"))
+        sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, membership)
+
+    collector = Collector()
+    try:
+        while True:
+            record, (host, _) = sock.recvfrom(2048)
+            try:
+                if args.raw:
+                    device_id, sequence, delta, fields = decode(record)
+                    result = {"device_id": device_id, "sequence": sequence, "delta": delta, "fields": fields}
+                else:
+                    result = collector.apply(record)
+            except DecodeError as err:
+                print("%s: %s" % (host, err), file=sys.stderr)
+                continue
+            if result is not None:
+                result["host"] = host
+                result["size"] = len(record)
+                print(json.dumps(result))
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()